@@ -5,6 +5,7 @@
    MIT License
 
    07/03/2026 - Original - by DRG-X (https://github.com/DRG-X)
+   10/16/2026 - Andy4495 - Print when each sample was read
    ----------------------------------------------------------------- */
 /* -----------------------------------------------------------------
    This example shows how to communicate with a typical register-based
@@ -15,6 +16,8 @@
      - Waking up a sensor by writing to a configuration register
      - Reading several consecutive data registers in one transaction
      - Combining a high byte and low byte into a signed 16-bit value
+     - Timestamping each read, for filters that need the sample times
+       (see also SWI2CSampler in SWI2C_Sampler.h)
 
    These same techniques apply to most other register-based I2C
    sensors, not just the MPU6050, so this sketch can also be used as
@@ -86,8 +89,10 @@ void loop() {
   if (currentMillis - lastMillis >= delayTime) {
     lastMillis = currentMillis;
 
-    // Read all 14 sensor bytes in a single I2C transaction.
-    int retval = myMPU.readFromRegister(ACCEL_XOUT_H, sensorData, SENSOR_DATA_LENGTH);
+    // Read all 14 sensor bytes in a single I2C transaction. The timestamp
+    // is micros() at the repeated START, just before the data is read.
+    unsigned long sampleTime, readTime;
+    int retval = myMPU.readFromRegister(ACCEL_XOUT_H, sensorData, SENSOR_DATA_LENGTH, sampleTime, readTime);
 
     if (retval == 0) {
       Serial.println("Error: Failed to read sensor data (NACK received).");
@@ -105,6 +110,8 @@ void loop() {
     float temperatureC = rawTemp / 340.0 + 36.53;
 
     Serial.println("---------------------------------");
+    Serial.print("Sample time: "); Serial.print(sampleTime);
+    Serial.print(" us (read took "); Serial.print(readTime); Serial.println(" us)");
     Serial.println("Accelerometer");
     Serial.print("  X: "); Serial.println(accelX);
     Serial.print("  Y: "); Serial.println(accelY);
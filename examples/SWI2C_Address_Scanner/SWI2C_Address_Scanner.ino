@@ -4,12 +4,15 @@
    MIT License
 
    08/17/2022 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Use scan() for a one-pass scan, and rescan() to
+                           detect devices that are added or removed
 */
 /* -----------------------------------------------------------------
 
-   I2C Address Scanner. 
-   This example uses several low-level class methods to implement 
-   the address scanner.
+   I2C Address Scanner.
+   This example uses the scan() method to probe all addresses in one
+   pass, then calls rescan() once a second to report devices that are
+   added or removed.
    - NXP Spec: https://www.nxp.com/docs/en/user-guide/UM10204.pdf
    - Reserved addresses (7-bit): 
      - 0000XXX: 0x00 - 0x07
@@ -36,21 +39,26 @@
 #define I2C_START_ADDRESS 0x08
 #define I2C_END_ADDRESS   0x77
 
-const unsigned long delayTime = 100;
+const unsigned long rescanTime = 1000;
 
 unsigned long lastmillis;
-int valid_address_found = 0; 
-uint8_t addr = I2C_START_ADDRESS;
-uint8_t valid_addresses[I2C_END_ADDRESS - I2C_START_ADDRESS + 1] = {0};
+SWI2C_ScanMap devices;
 
-// Initally setting I2C device address at 0; address will be updated during scan loop below.
+// The device address is not used by scan(), so it is set to 0.
 SWI2C myScanner = SWI2C(SDA_PIN, SCL_PIN, 0);
 
+void printAddress(uint8_t addr) {
+  if (addr <= 0x0F) Serial.print(" 0x0");
+  else Serial.print(" 0x");
+  Serial.print(addr, HEX);
+}
+
 void setup() {
+  uint8_t found;
+  unsigned long scanTime;
+
   Serial.begin(9600);
   myScanner.begin();
-  myScanner.setStretchTimeout(100);
-  lastmillis = millis();
   Serial.println("");
   Serial.println("");
   Serial.println("SWI2C Address Scanner.");
@@ -60,61 +68,58 @@ void setup() {
   Serial.print(I2C_END_ADDRESS, HEX);
   Serial.println(" will be scanned.");
   Serial.println("Other addresses are reserved and will not be scanned.");
-  Serial.print("Scanning");
+
+  scanTime = micros();
+  found = myScanner.scan(devices, I2C_START_ADDRESS, I2C_END_ADDRESS);
+  scanTime = micros() - scanTime;
+
+  if (found) {
+    if (found == 1) Serial.println("I2C device found.");
+    else Serial.println("I2C devices found.");
+    Serial.println("----- ----------- ----------");
+    Serial.println("7-bit 8-bit Write 8-bit Read");
+    Serial.println("----- ----------- ----------");
+    for (int i = I2C_START_ADDRESS; i <= I2C_END_ADDRESS; i++ ) {
+      if (devices.isPresent(i)) {
+        printAddress(i);
+        Serial.print("     0x");
+        Serial.print((i<<1), HEX);
+        Serial.print("       0x");
+        Serial.println((i<<1) + 1, HEX);
+      }
+    }
+  } else {
+    Serial.println("No I2C devices found.");
+  }
+  for (int i = I2C_START_ADDRESS; i <= I2C_END_ADDRESS; i++ ) {
+    if (devices.isStretched(i)) {
+      Serial.print("Clock stretch timeout detected at");
+      printAddress(i);
+      Serial.println(". Check hardware and pin numbers.");
+    }
+  }
+  Serial.print("Scan time (us): ");
+  Serial.println(scanTime);
+  Serial.println("");
+  Serial.println("Watching for devices that are added or removed.");
+  lastmillis = millis();
 }
 
 void loop() {
   unsigned long currentmillis = millis();
 
-  if (currentmillis - lastmillis > delayTime) {
+  if (currentmillis - lastmillis > rescanTime) {
     lastmillis = currentmillis;
 
-    // Use low-level methods. We are only sending the address and no data bytes
-    myScanner.setDeviceID(addr);
-    myScanner.startBit();
-    myScanner.writeAddress(0);
-    if (myScanner.checkAckBit() == 0 ) {  // If ACK detected, then valid address found
-      if (myScanner.checkStretchTimeout()) { // Unless a clock stretch timeout was detected
-        valid_addresses[addr - I2C_START_ADDRESS] = 2;
-      } else {     
-        valid_addresses[addr - I2C_START_ADDRESS] = 1;
-      }
-      valid_address_found++;
-    }
-    myScanner.stopBit(); 
-
-    Serial.print(".");
-
-    if (++addr > I2C_END_ADDRESS) {
-        Serial.println("");
-        if (valid_address_found) {
-            if (valid_address_found == 1) Serial.println("I2C device found.");
-            else Serial.println("I2C devices found.");
-            Serial.println("----- ----------- ----------");
-            Serial.println("7-bit 8-bit Write 8-bit Read");
-            Serial.println("----- ----------- ----------");
-            for (int i = I2C_START_ADDRESS; i <= I2C_END_ADDRESS; i++ ) {
-                if (valid_addresses[i - I2C_START_ADDRESS]) {
-                    if (i <= 0x0F) Serial.print(" 0x0");
-                    else Serial.print(" 0x");
-                    Serial.print(i, HEX);
-                    Serial.print("     0x");
-                    Serial.print((i<<1), HEX);
-                    Serial.print("       0x");
-                    Serial.print((i<<1) + 1, HEX);
-                    if (valid_addresses[i - I2C_START_ADDRESS] == 2) {
-                      Serial.print("    <-- Clock stretch timeout detected. Address may be invalid. ");
-                      Serial.print("Check hardware and pin numbers.");
-                    }
-                    Serial.println("");
-                }
-            }
-        } else {
-            Serial.println("No I2C devices found.");
+    if (myScanner.rescan(devices)) {
+      for (int i = I2C_START_ADDRESS; i <= I2C_END_ADDRESS; i++ ) {
+        if (devices.isChanged(i)) {
+          Serial.print("Device");
+          printAddress(i);
+          if (devices.isPresent(i)) Serial.println(" added.");
+          else Serial.println(" removed.");
         }
-        Serial.println("");
-        Serial.println("Reset to start new scan.");
-        while (1); // Loop forever
+      }
     }
   }
-}
\ No newline at end of file
+}
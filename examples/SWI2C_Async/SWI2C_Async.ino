@@ -0,0 +1,97 @@
+/* -----------------------------------------------------------------
+   SWI2C Async
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Reads a slow ADC that stretches the clock, without blocking loop().
+
+   The ADC is a simulated device (SWI2C_SimBus.h), so no I2C hardware
+   is needed. It holds SCL low for 50 samples after every clock.
+   With the blocking readFromRegister(), loop() would wait for every
+   one of those samples. With SWI2CAsync, loop() keeps running its
+   other work while the transfer is advanced by poll().
+
+   With real hardware, use SWI2CAsync with an SWI2CBus:
+     SWI2CBus bus(SDA_PIN, SCL_PIN);
+     SWI2CAsync adc(bus);
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+#include "SWI2C_Async.h"
+
+#define ADC_ADDRESS    0x48
+#define RESULT_REGISTER   0
+
+SWI2C_SimBus simBus;
+uint8_t adcRegisters[4] = {0x12, 0x34, 0x00, 0x00};
+SWI2C_SimRegisterDevice adcModel(ADC_ADDRESS, adcRegisters, sizeof(adcRegisters));
+
+SWI2CBusSim bus(simBus);
+SWI2CAsyncT<SWI2CBusSim> adc(bus);
+
+uint8_t resultRegister = RESULT_REGISTER;
+uint8_t sample[2];
+uint8_t status[2];
+SWI2C_Msg msgs[2] = {
+  {ADC_ADDRESS, 0, 1, &resultRegister},
+  {ADC_ADDRESS, SWI2C_M_RD, 2, sample}
+};
+
+volatile bool sampleReady = false;
+unsigned long otherWork = 0;
+unsigned long polls = 0;
+uint8_t samplesRead = 0;
+
+void onSampleDone(int completed) {
+  if (completed == 2) sampleReady = true;
+  else {
+    Serial.print("Error: message status ");
+    Serial.print(status[0]);
+    Serial.print(",");
+    Serial.println(status[1]);
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  adcModel.setClockStretch(50);
+  simBus.attach(adcModel);
+  bus.begin();
+
+  Serial.println("");
+  Serial.println("SWI2C Async.");
+  Serial.println("sample,value,polls,other_work");
+}
+
+void loop() {
+  if (samplesRead >= 5) return;
+
+  if (!adc.isBusy() && !sampleReady) {
+    adc.startTransfer(msgs, 2, status, onSampleDone);
+    polls = 0;
+    otherWork = 0;
+  }
+
+  polls++;
+  adc.poll();
+
+  if (sampleReady) {
+    sampleReady = false;
+    Serial.print(samplesRead++);
+    Serial.print(",0x");
+    Serial.print((sample[0] << 8) | sample[1], HEX);
+    Serial.print(",");
+    Serial.print(polls);
+    Serial.print(",");
+    Serial.println(otherWork);
+    adcRegisters[1]++;
+  }
+
+  // The control loop keeps running while the ADC stretches the clock
+  otherWork++;
+}
@@ -0,0 +1,134 @@
+/* -----------------------------------------------------------------
+   SWI2C Benchmark
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Report SCL frequency for each speed profile
+*/
+/* -----------------------------------------------------------------
+
+   Compares the cost of the bit-bang core with runtime pins (SWI2C)
+   and with compile-time pins (SWI2CT).
+
+   Each test repeats a low-level operation many times and prints the
+   average time per call in microseconds and, where F_CPU is known,
+   in CPU cycles.
+
+   It then calibrates each bus speed profile (setSpeed()) and prints
+   the SCL frequency achieved.
+
+   The low-level methods used here clock the bus whether or not a
+   device is attached, but SDA and SCL need pull-up resistors.
+   Without pull-ups, SCL never reads high and every clock waits for
+   the clock-stretching timeout.
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C.h"
+
+#define SCL_PIN 9
+#define SDA_PIN 10
+#define DEVICE_ADDRESS 0x68  // Any address; the results don't depend on an ACK
+
+const unsigned int iterations = 1000;
+
+SWI2C runtimePins = SWI2C(SDA_PIN, SCL_PIN, DEVICE_ADDRESS);
+SWI2CT<SDA_PIN, SCL_PIN> fixedPins = SWI2CT<SDA_PIN, SCL_PIN>(DEVICE_ADDRESS);
+
+void printResult(const char* variant, const char* operation, unsigned long elapsed) {
+  Serial.print(variant);
+  Serial.print(",");
+  Serial.print(operation);
+  Serial.print(",");
+  Serial.print((float) elapsed / iterations);
+#ifdef F_CPU
+  Serial.print(",");
+  Serial.print((elapsed * (F_CPU / 1000000UL)) / iterations);
+#endif
+  Serial.println("");
+}
+
+// Template so both variants are measured with identical code
+template <class DEVICE>
+void runBenchmark(DEVICE& device, const char* variant) {
+  unsigned long start;
+  volatile uint8_t value;
+
+  device.setStretchTimeout(10);
+
+  start = micros();
+  for (unsigned int i = 0; i < iterations; i++) {
+    device.sdaLo();
+    device.sdaHi();
+  }
+  printResult(variant, "sdaLo+sdaHi", micros() - start);
+
+  start = micros();
+  for (unsigned int i = 0; i < iterations; i++) {
+    device.sclLo();
+    device.sclHi();
+  }
+  printResult(variant, "sclLo+sclHi", micros() - start);
+
+  device.startBit();
+  start = micros();
+  for (unsigned int i = 0; i < iterations; i++) {
+    device.writeByte(0x55);
+    device.sclHi();    // Stand-in for the ACK clock
+    device.sclLo();
+  }
+  printResult(variant, "writeByte", micros() - start);
+
+  start = micros();
+  for (unsigned int i = 0; i < iterations; i++) {
+    value = device.read1Byte();
+    device.writeAck();
+  }
+  printResult(variant, "read1Byte", micros() - start);
+  device.stopBit();
+  (void) value;
+
+  if (device.checkStretchTimeout()) {
+    Serial.print(variant);
+    Serial.println(": clock stretch timeout detected. Check pull-up resistors.");
+  }
+}
+
+template <class DEVICE>
+void runSpeeds(DEVICE& device, const char* variant) {
+  const unsigned long speeds[] = {SWI2C_SPEED_MAX, SWI2C_SPEED_STANDARD, SWI2C_SPEED_FAST};
+
+  for (uint8_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+    device.setSpeed(speeds[i]);
+    Serial.print(variant);
+    Serial.print(",");
+    Serial.print(speeds[i]);
+    Serial.print(",");
+    Serial.println(device.calibrate());
+  }
+  device.setSpeed(SWI2C_SPEED_MAX);
+  device.calibrate();
+}
+
+void setup() {
+  Serial.begin(9600);
+  runtimePins.begin();
+  fixedPins.begin();
+  Serial.println("");
+  Serial.println("SWI2C Benchmark.");
+#ifdef F_CPU
+  Serial.println("variant,operation,us_per_call,cycles_per_call");
+#else
+  Serial.println("variant,operation,us_per_call");
+#endif
+  runBenchmark(runtimePins, "SWI2C");
+  runBenchmark(fixedPins, "SWI2CT");
+
+  Serial.println("variant,target_hz,achieved_hz");
+  runSpeeds(runtimePins, "SWI2C");
+  runSpeeds(fixedPins, "SWI2CT");
+}
+
+void loop() {
+}
@@ -0,0 +1,177 @@
+/* -----------------------------------------------------------------
+   SWI2C Bus Cost Benchmark
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Baseline includes the SDA check before each
+                           transaction on a shared bus
+*/
+/* -----------------------------------------------------------------
+
+   Reports the bus cost of every high level SWI2C method, measured on
+   the simulated bus (SWI2C_SimBus.h), so no I2C hardware is needed
+   and the results are the same on every board.
+
+   For each method and payload size the sketch prints one CSV line:
+     method,bytes,pin_writes,pin_reads,millis_calls,scl_pulses,bus_us
+   bus_us is simulated bus time, using the pin timing set below.
+
+   It then prints a summary line per method with the fixed
+   (per-transaction) and per-byte pin operations, and the difference
+   from the stored baseline below:
+     summary,method,fixed_writes,per_byte_writes,fixed_reads,per_byte_reads,
+             fixed_millis,delta_fixed_writes,delta_per_byte_writes,
+             delta_fixed_reads,delta_per_byte_reads,delta_fixed_millis
+   A non-zero delta means the library has become more (positive) or
+   less (negative) expensive than the baseline. Update the baseline
+   table when a change is intended.
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+
+#define DEVICE_ADDRESS 0x68
+#define DATA_PATTERN   0x55   // Alternating bits: worst case for SDA edges
+
+// Simulated cost of one pin write and one pin read (ns)
+const unsigned int pinWriteNs = 1000;
+const unsigned int pinReadNs = 1000;
+
+// To save RAM, the same array is the device's register file and the
+// sketch's data buffer. Every byte holds DATA_PATTERN, so reads and
+// writes leave it unchanged.
+uint8_t buffer[256];
+
+SWI2C_SimBus bus;
+SWI2C_SimRegisterDevice model(DEVICE_ADDRESS, buffer, sizeof(buffer));
+SWI2CSim myDevice(bus, DEVICE_ADDRESS);
+
+// Wrappers so every method can be called through the same function pointer
+int runWriteToRegister1(uint8_t)        {return myDevice.writeToRegister(0, DATA_PATTERN);}
+int runWriteToRegisterN(uint8_t n)      {return myDevice.writeToRegister(0, buffer, n);}
+int runWriteToDevice1(uint8_t)          {return myDevice.writeToDevice(DATA_PATTERN);}
+int runWriteToDeviceN(uint8_t n)        {return myDevice.writeToDevice(buffer, n);}
+int runReadFromRegister1(uint8_t)       {return myDevice.readFromRegister(0, buffer[0]);}
+int runReadFromRegisterN(uint8_t n)     {return myDevice.readFromRegister(0, buffer, n);}
+int runReadFromDevice1(uint8_t)         {return myDevice.readFromDevice(buffer[0]);}
+int runReadFromDeviceN(uint8_t n)       {return myDevice.readFromDevice(buffer, n);}
+int runWrite1bToRegister(uint8_t)       {return myDevice.write1bToRegister(0, DATA_PATTERN);}
+int runWrite2bToRegister(uint8_t)       {return myDevice.write2bToRegister(0, 0x5555);}
+int runWrite2bToRegisterMSB(uint8_t)    {return myDevice.write2bToRegisterMSBFirst(0, 0x5555);}
+int runWriteBytesToRegister(uint8_t n)  {return myDevice.writeBytesToRegister(0, buffer, n);}
+int runWrite1bToDevice(uint8_t)         {return myDevice.write1bToDevice(DATA_PATTERN);}
+int runWriteBytesToDevice(uint8_t n)    {return myDevice.writeBytesToDevice(buffer, n);}
+int runRead1bFromRegister(uint8_t)      {return myDevice.read1bFromRegister(0, buffer);}
+int runRead2bFromRegister(uint8_t)      {uint16_t d; return myDevice.read2bFromRegister(0, &d);}
+int runRead2bFromRegisterMSB(uint8_t)   {uint16_t d; return myDevice.read2bFromRegisterMSBFirst(0, &d);}
+int runReadBytesFromRegister(uint8_t n) {return myDevice.readBytesFromRegister(0, buffer, n);}
+int runRead1bFromDevice(uint8_t)        {return myDevice.read1bFromDevice(buffer);}
+int runReadBytesFromDevice(uint8_t n)   {return myDevice.readBytesFromDevice(buffer, n);}
+
+struct Benchmark {
+  const char* name;
+  int (*run)(uint8_t count);
+  bool variableLength;
+  // Baseline: fixed writes, per-byte writes, fixed reads, per-byte reads, fixed millis() calls
+  int baseline[5];
+};
+
+const Benchmark benchmarks[] = {
+  {"writeToRegister(data)",        runWriteToRegister1,      false, {75, 0, 33, 0, 0}},
+  {"writeToRegister(buffer)",      runWriteToRegisterN,      true,  {49, 26, 23, 10, 0}},
+  {"writeToDevice(data)",          runWriteToDevice1,        false, {55, 0, 23, 0, 0}},
+  {"writeToDevice(buffer)",        runWriteToDeviceN,        true,  {29, 26, 13, 10, 0}},
+  {"readFromRegister(data)",       runReadFromRegister1,     false, {93, 0, 52, 0, 0}},
+  {"readFromRegister(buffer)",     runReadFromRegisterN,     true,  {73, 20, 35, 17, 0}},
+  {"readFromDevice(data)",         runReadFromDevice1,       false, {47, 0, 31, 0, 0}},
+  {"readFromDevice(buffer)",       runReadFromDeviceN,       true,  {27, 20, 14, 17, 0}},
+  {"write1bToRegister",            runWrite1bToRegister,     false, {75, 0, 33, 0, 0}},
+  {"write2bToRegister",            runWrite2bToRegister,     false, {101, 0, 43, 0, 0}},
+  {"write2bToRegisterMSBFirst",    runWrite2bToRegisterMSB,  false, {101, 0, 43, 0, 0}},
+  {"writeBytesToRegister",         runWriteBytesToRegister,  true,  {49, 26, 23, 10, 0}},
+  {"write1bToDevice",              runWrite1bToDevice,       false, {55, 0, 23, 0, 0}},
+  {"writeBytesToDevice",           runWriteBytesToDevice,    true,  {29, 26, 13, 10, 0}},
+  {"read1bFromRegister",           runRead1bFromRegister,    false, {93, 0, 52, 0, 0}},
+  {"read2bFromRegister",           runRead2bFromRegister,    false, {113, 0, 69, 0, 0}},
+  {"read2bFromRegisterMSBFirst",   runRead2bFromRegisterMSB, false, {113, 0, 69, 0, 0}},
+  {"readBytesFromRegister",        runReadBytesFromRegister, true,  {73, 20, 35, 17, 0}},
+  {"read1bFromDevice",             runRead1bFromDevice,      false, {47, 0, 31, 0, 0}},
+  {"readBytesFromDevice",          runReadBytesFromDevice,   true,  {27, 20, 14, 17, 0}},
+};
+
+const uint8_t payloadSizes[] = {1, 2, 4, 8, 16, 32, 64, 128, 255};
+
+SWI2C_SimBus::Counters measure(const Benchmark& b, uint8_t count) {
+  bus.resetCounters();
+  if (b.run(count) == 0) Serial.println("Error: NACK received.");
+  return bus.getTransactionCounters();
+}
+
+void printRow(const char* name, uint8_t count, const SWI2C_SimBus::Counters& c) {
+  Serial.print(name);
+  Serial.print(",");
+  Serial.print(count);
+  Serial.print(",");
+  Serial.print(c.pinWrites);
+  Serial.print(",");
+  Serial.print(c.pinReads);
+  Serial.print(",");
+  Serial.print(c.timeReads);
+  Serial.print(",");
+  Serial.print(c.sclPulses);
+  Serial.print(",");
+  Serial.println(c.busTime);
+}
+
+void setup() {
+  Serial.begin(9600);
+  memset(buffer, DATA_PATTERN, sizeof(buffer));
+  bus.setPinTiming(pinWriteNs, pinReadNs);
+  bus.attach(model);
+  myDevice.begin();
+
+  Serial.println("");
+  Serial.println("SWI2C Bus Cost Benchmark.");
+  Serial.println("method,bytes,pin_writes,pin_reads,millis_calls,scl_pulses,bus_us");
+
+  for (uint8_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+    const Benchmark& b = benchmarks[i];
+    long result[5];
+    SWI2C_SimBus::Counters first = measure(b, 1);
+    SWI2C_SimBus::Counters last = first;
+
+    printRow(b.name, 1, first);
+    if (b.variableLength) {
+      for (uint8_t j = 1; j < sizeof(payloadSizes); j++) {
+        last = measure(b, payloadSizes[j]);
+        printRow(b.name, payloadSizes[j], last);
+      }
+      // With a constant data pattern, cost is linear in the payload size
+      result[1] = (long)(last.pinWrites - first.pinWrites) / (payloadSizes[sizeof(payloadSizes) - 1] - 1);
+      result[3] = (long)(last.pinReads - first.pinReads) / (payloadSizes[sizeof(payloadSizes) - 1] - 1);
+    }
+    else {
+      result[1] = 0;
+      result[3] = 0;
+    }
+    result[0] = first.pinWrites - result[1];
+    result[2] = first.pinReads - result[3];
+    result[4] = first.timeReads;
+
+    Serial.print("summary,");
+    Serial.print(b.name);
+    for (uint8_t k = 0; k < 5; k++) {
+      Serial.print(",");
+      Serial.print(result[k]);
+    }
+    for (uint8_t k = 0; k < 5; k++) {
+      Serial.print(",");
+      Serial.print(result[k] - b.baseline[k]);
+    }
+    Serial.println("");
+  }
+}
+
+void loop() {
+}
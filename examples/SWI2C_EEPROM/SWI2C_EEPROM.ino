@@ -0,0 +1,83 @@
+/* -----------------------------------------------------------------
+   SWI2C EEPROM
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Writes a 200-byte configuration block to a 24C256-style EEPROM
+   (16-bit memory addresses, 64-byte pages) with SWI2CEEPROM, reads it
+   back, and prints the write time.
+
+   The block starts part way through a page, so it is written as four
+   page writes. After each page, SWI2CEEPROM polls the device address
+   until the write cycle is finished, instead of waiting a fixed 5 ms.
+   The simulated EEPROM takes 3.5 ms per write cycle, so the write takes
+   about 4 x 3.5 ms plus the bus time, instead of 4 x 5 ms plus the bus time.
+
+   The EEPROM is simulated (SWI2C_SimBus.h), so no I2C hardware is
+   needed. With real hardware, use:
+     SWI2C eepromDevice(SDA_PIN, SCL_PIN, 0x50);
+     SWI2CEEPROM<SWI2C> eeprom(eepromDevice, 64, 2);
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+#include "SWI2C_EEPROM.h"
+
+#define CONFIG_ADDRESS  0x0120
+#define CONFIG_SIZE     200
+
+SWI2C_SimBus simBus;
+uint8_t memory[1024];
+SWI2C_SimEEPROMDevice eepromModel(0x50, memory, sizeof(memory), 64, 2, 3500);
+
+SWI2CBusSim bus(simBus);
+SWI2CDeviceSim eepromDevice(bus, 0x50);
+SWI2CEEPROM<SWI2CDeviceSim> eeprom(eepromDevice, 64, 2);
+
+uint8_t config[CONFIG_SIZE];
+uint8_t readBack[CONFIG_SIZE];
+
+void setup() {
+  unsigned long startTime;
+  unsigned long writeTime;
+
+  Serial.begin(9600);
+  simBus.setPinTiming(250, 250);
+  simBus.attach(eepromModel);
+  bus.begin();
+  for (uint16_t i = 0; i < CONFIG_SIZE; i++) config[i] = i ^ 0x5A;
+
+  Serial.println("");
+  Serial.println("SWI2C EEPROM.");
+
+  startTime = simBus.getMicros();
+  if (eeprom.write(CONFIG_ADDRESS, config, CONFIG_SIZE) == 0) {
+    Serial.print("Write failed, error ");
+    Serial.println(eeprom.getLastError());
+    return;
+  }
+  writeTime = simBus.getMicros() - startTime;
+  Serial.print("Wrote ");
+  Serial.print(CONFIG_SIZE);
+  Serial.print(" bytes in ");
+  Serial.print(eepromModel.getWriteCycles());
+  Serial.print(" pages: ");
+  Serial.print(writeTime);
+  Serial.print(" us, ");
+  Serial.print(eeprom.getPolls());
+  Serial.println(" polls while busy");
+
+  if (eeprom.read(CONFIG_ADDRESS, readBack, CONFIG_SIZE) == 0) {
+    Serial.print("Read failed, error ");
+    Serial.println(eeprom.getLastError());
+    return;
+  }
+  Serial.println(memcmp(config, readBack, CONFIG_SIZE) == 0 ? "Read back OK." : "Read back does not match.");
+}
+
+void loop() {
+}
@@ -0,0 +1,145 @@
+/* -----------------------------------------------------------------
+   SWI2C Interrupt
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Reads a sensor from an interrupt handler while loop() uses the same
+   bus for long reads from another device:
+     - 0x68 (like the MPU6050): a data-ready interrupt every 1 ms. The
+       handler reads the 6 accelerometer bytes (0x3B-0x40) with
+       requestFromRegister().
+     - 0x50: loop() reads 64 bytes at a time, which takes most of a
+       millisecond at this bus speed.
+
+   When the interrupt finds the bus free, the read runs right away in the
+   handler. When it interrupts one of loop()'s reads, the read is queued
+   and runs right after that read's STOP. Both sets of data are checked.
+   After one second, the lock statistics and the time from each
+   interrupt to its data are printed.
+
+   The devices and the interrupt are simulated (SWI2C_SimBus.h), so no
+   I2C hardware is needed, and time is simulated time. With real
+   hardware, use SWI2CBus and SWI2CDevice, and attach the handler to the
+   sensor's interrupt pin:
+     SWI2CBus bus(SDA_PIN, SCL_PIN);
+     SWI2CDevice imu(bus, 0x68);
+     attachInterrupt(digitalPinToInterrupt(INT_PIN), onDataReady, RISING);
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+
+SWI2C_SimBus simBus;
+uint8_t imuRegisters[128];
+uint8_t logRegisters[128];
+SWI2C_SimRegisterDevice imuModel(0x68, imuRegisters, sizeof(imuRegisters));
+SWI2C_SimRegisterDevice logModel(0x50, logRegisters, sizeof(logRegisters));
+
+SWI2CBusSim bus(simBus);
+SWI2CDeviceSim imu(bus, 0x68);
+SWI2CDeviceSim logger(bus, 0x50);
+
+SWI2C_Request requestEntries[4];
+SWI2C_RequestQueue requests(requestEntries, 4);
+
+volatile uint16_t latched;       // Sample number the sensor latched at the interrupt
+volatile unsigned long interruptTime;
+uint8_t sample[6];
+unsigned long samples = 0;
+unsigned long sampleErrors = 0;
+unsigned long maxLatency = 0;
+unsigned long totalLatency = 0;
+
+unsigned long logReads = 0;
+unsigned long logErrors = 0;
+unsigned long startTime;
+bool done = false;
+
+void onSample(void* context, int result) {
+  (void)context;
+  unsigned long latency = simBus.getMicros() - interruptTime;
+  samples++;
+  if (!result || sample[0] != (latched & 0xFF) || sample[1] != (latched >> 8) ||
+      sample[2] != (uint8_t)~sample[0] || sample[5] != 0x5A) sampleErrors++;
+  totalLatency += latency;
+  if (latency > maxLatency) maxLatency = latency;
+}
+
+void onDataReady() {
+  // The sensor latches a new sample, then raises its interrupt pin
+  latched++;
+  imuRegisters[0x3B] = latched & 0xFF;
+  imuRegisters[0x3C] = latched >> 8;
+  imuRegisters[0x3D] = ~(latched & 0xFF);
+  imuRegisters[0x40] = 0x5A;
+  interruptTime = simBus.getInterruptTime();
+  imu.requestFromRegister(0x3B, sample, 6, onSample);
+}
+
+void setup() {
+  Serial.begin(9600);
+
+  for (uint8_t i = 0; i < sizeof(logRegisters); i++) logRegisters[i] = i * 7;
+  simBus.setPinTiming(250, 250);
+  simBus.attach(imuModel);
+  simBus.attach(logModel);
+  bus.begin();
+  bus.setRequestQueue(&requests);
+  simBus.setInterrupt(onDataReady, 1000, 1000);
+  startTime = simBus.getMicros();
+
+  Serial.println("");
+  Serial.println("SWI2C Interrupt.");
+}
+
+void loop() {
+  uint8_t buffer[64];
+  uint8_t start;
+
+  if (done) return;
+  start = (logReads & 1) ? 64 : 0;
+  if (logger.readFromRegister(start, buffer, sizeof(buffer))) {
+    for (uint8_t i = 0; i < sizeof(buffer); i++) {
+      if (buffer[i] != (uint8_t)((start + i) * 7)) {
+        logErrors++;
+        break;
+      }
+    }
+  }
+  else logErrors++;
+  logReads++;
+  simBus.idle(300);   // Other work
+  if (simBus.getMicros() - startTime < 1000000UL) return;
+
+  simBus.setInterrupt(0, 0, 0);
+  const SWI2C_LockStats& s = requests.getStats();
+  Serial.print("Interrupts: ");
+  Serial.print(simBus.getInterrupts());
+  Serial.print(", samples: ");
+  Serial.print(samples);
+  Serial.print(", sample errors: ");
+  Serial.println(sampleErrors);
+  Serial.print("Run in the handler: ");
+  Serial.print(s.requests - s.queued - s.dropped);
+  Serial.print(", queued: ");
+  Serial.print(s.queued);
+  Serial.print(", dropped: ");
+  Serial.println(s.dropped);
+  Serial.print("Queue wait (us): mean ");
+  Serial.print(s.queued ? s.totalQueueWait / s.queued : 0);
+  Serial.print(", max ");
+  Serial.println(s.maxQueueWait);
+  Serial.print("Interrupt to data (us): mean ");
+  Serial.print(samples ? totalLatency / samples : 0);
+  Serial.print(", max ");
+  Serial.println(maxLatency);
+  Serial.print("loop() reads: ");
+  Serial.print(logReads);
+  Serial.print(", errors: ");
+  Serial.println(logErrors);
+  done = true;
+}
@@ -0,0 +1,67 @@
+/* -----------------------------------------------------------------
+   SWI2C Multi
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Reads four identical temperature sensors (LM75 or TMP102, all at
+   address 0x48) in a single transaction. Each sensor has its own SDA
+   pin, and all four share one SCL pin.
+
+   On an Uno, SDA pins 2 to 5 are all on PORTD, so each SDA edge and
+   each bit read is a single port access for all four sensors.
+
+   Each SDA line and the SCL line need a pull-up resistor.
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_Multi.h"
+
+#define SCL_PIN 6
+#define SENSOR_ADDRESS 0x48
+#define TEMPERATURE_REGISTER 0x00
+#define SENSOR_COUNT 4
+
+const uint8_t sdaPins[SENSOR_COUNT] = {2, 3, 4, 5};
+
+SWI2CMulti sensors(sdaPins, SENSOR_COUNT, SCL_PIN, SENSOR_ADDRESS);
+
+void setup() {
+  Serial.begin(9600);
+  sensors.begin();
+  Serial.println("");
+  Serial.println("SWI2C Multi.");
+}
+
+void loop() {
+  uint8_t data[SENSOR_COUNT * 2];   // 2 bytes per sensor: data[sensor * 2 + i]
+  uint8_t present;
+  unsigned long start;
+  unsigned long elapsed;
+
+  start = micros();
+  present = sensors.readFromRegister(TEMPERATURE_REGISTER, data, 2);
+  elapsed = micros() - start;
+
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    Serial.print("Sensor ");
+    Serial.print(i);
+    Serial.print(": ");
+    if (present & (1 << i)) {
+      // Temperature is MSB first, in units of 1/256 degree C
+      int16_t raw = (data[i * 2] << 8) | data[i * 2 + 1];
+      Serial.print(raw / 256.0);
+      Serial.println(" C");
+    }
+    else {
+      Serial.println("no response");
+    }
+  }
+  Serial.print("Read time for all sensors (us): ");
+  Serial.println(elapsed);
+  Serial.println("");
+  delay(2000);
+}
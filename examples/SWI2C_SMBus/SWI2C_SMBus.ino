@@ -0,0 +1,91 @@
+/* -----------------------------------------------------------------
+   SWI2C SMBus
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Reads a Smart Battery (SBS) with SWI2CSMBus, with Packet Error
+   Checking (PEC) enabled: Voltage() and Temperature() as words, and
+   ManufacturerName() as a block. Then the battery model is set to send
+   a wrong PEC byte, to show that the error is detected.
+
+   The battery is simulated (SWI2C_SimBus.h), so no I2C hardware is
+   needed. With real hardware, use:
+     SWI2C battery(SDA_PIN, SCL_PIN, 0x0B);
+     SWI2CSMBus<SWI2C> smbus(battery, true);
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+#include "SWI2C_SMBus.h"
+
+#define SBS_ADDRESS            0x0B
+#define SBS_TEMPERATURE        0x08   // 0.1 K
+#define SBS_VOLTAGE            0x09   // mV
+#define SBS_MANUFACTURER_NAME  0x20   // Block
+
+SWI2C_SimBus simBus;
+uint16_t batteryWords[0x20];
+uint8_t batteryName[SWI2C_SMBUS_BLOCK_MAX];
+SWI2C_SimSMBusDevice batteryModel(SBS_ADDRESS, batteryWords, 0x20,
+                                  SBS_MANUFACTURER_NAME, batteryName, sizeof(batteryName));
+
+SWI2CBusSim bus(simBus);
+SWI2CDeviceSim battery(bus, SBS_ADDRESS);
+SWI2CSMBus<SWI2CDeviceSim> smbus(battery, true);
+
+void printError() {
+  Serial.print("failed, error ");
+  Serial.println(smbus.getLastError());
+}
+
+void setup() {
+  uint16_t value;
+  uint8_t name[SWI2C_SMBUS_BLOCK_MAX + 1];
+  uint8_t length;
+
+  Serial.begin(9600);
+  batteryWords[SBS_TEMPERATURE] = 2982;   // 25.0 C
+  batteryWords[SBS_VOLTAGE] = 11234;
+  memcpy(batteryName, "ACME", 4);
+  batteryModel.setBlockLength(4);
+  batteryModel.setPEC(true);
+  simBus.attach(batteryModel);
+  bus.begin();
+
+  Serial.println("");
+  Serial.println("SWI2C SMBus.");
+
+  Serial.print("Voltage: ");
+  if (smbus.readWordData(SBS_VOLTAGE, value)) {
+    Serial.print(value);
+    Serial.println(" mV");
+  }
+  else printError();
+
+  Serial.print("Temperature: ");
+  if (smbus.readWordData(SBS_TEMPERATURE, value)) {
+    Serial.print((value - 2732) / 10);
+    Serial.println(" C");
+  }
+  else printError();
+
+  Serial.print("Manufacturer: ");
+  if (smbus.blockRead(SBS_MANUFACTURER_NAME, name, length)) {
+    name[length] = 0;
+    Serial.println((char*)name);
+  }
+  else printError();
+
+  batteryModel.setCorruptPEC(true);
+  Serial.print("Voltage with a corrupted PEC: ");
+  if (smbus.readWordData(SBS_VOLTAGE, value)) Serial.println(value);
+  else if (smbus.getLastError() == SWI2C_MSG_PEC_ERROR) Serial.println("PEC error detected.");
+  else printError();
+}
+
+void loop() {
+}
@@ -0,0 +1,117 @@
+/* -----------------------------------------------------------------
+   SWI2C Sampler
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Samples the 14 accelerometer, temperature, and gyro registers of a
+   device like the MPU6050 every 1 ms with SWI2CSampler, which stores
+   each read with the time it was taken. Every few passes, loop() also
+   reads an ADC on the same bus that stretches the clock, which delays
+   some of the samples.
+
+   The first 10 records are printed as CSV, then the interval and jitter
+   statistics after 500 samples. A fusion filter would use the record
+   timestamps in place of a fixed 1 ms sample period.
+
+   The devices are simulated (SWI2C_SimBus.h), so no I2C hardware is
+   needed, and time is simulated time. With real hardware, use SWI2CBus
+   and SWI2CDevice:
+     SWI2CBus bus(SDA_PIN, SCL_PIN);
+     SWI2CDevice imu(bus, 0x68);
+     SWI2CSampler<SWI2CDevice, 14> sampler(imu, 0x3B, samples, 16);
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+#include "SWI2C_Sampler.h"
+
+SWI2C_SimBus simBus;
+uint8_t imuRegisters[128];
+uint8_t adcRegisters[4];
+SWI2C_SimRegisterDevice imuModel(0x68, imuRegisters, sizeof(imuRegisters));
+SWI2C_SimRegisterDevice adcModel(0x48, adcRegisters, sizeof(adcRegisters));
+
+SWI2CBusSim bus(simBus);
+SWI2CDeviceSim imu(bus, 0x68);
+SWI2CDeviceSim adc(bus, 0x48);
+
+SWI2C_Sample<14> samples[16];
+SWI2CSampler<SWI2CDeviceSim, 14> sampler(imu, 0x3B, samples, 16);
+
+const unsigned long samplePeriod = 1000;   // us
+unsigned long nextSample;
+unsigned long passes = 0;
+unsigned long printed = 0;
+unsigned long lastTimestamp = 0;
+bool done = false;
+
+void setup() {
+  Serial.begin(9600);
+
+  for (uint8_t i = 0; i < 14; i++) imuRegisters[0x3B + i] = i;
+  simBus.setPinTiming(250, 250);
+  simBus.attach(imuModel);
+  simBus.attach(adcModel);
+  adcModel.setClockStretch(40);   // Each ADC byte holds SCL low for 40 samples
+  bus.begin();
+  nextSample = simBus.getMicros();
+
+  Serial.println("");
+  Serial.println("SWI2C Sampler.");
+  Serial.println("timestamp_us,duration_us,interval_us,first_byte");
+}
+
+void loop() {
+  uint8_t reading[2];
+  SWI2C_Sample<14> record;
+
+  if (done) return;
+  if ((long)(simBus.getMicros() - nextSample) >= 0) {
+    nextSample += samplePeriod;
+    sampler.sample();
+  }
+  if (++passes % 7 == 0) adc.readFromRegister(0x00, reading, 2);   // Delays the next sample
+  simBus.idle(150);   // Other work
+
+  while (sampler.take(record)) {
+    if (printed < 10) {
+      Serial.print(record.timestamp);
+      Serial.print(",");
+      Serial.print(record.duration);
+      Serial.print(",");
+      Serial.print(printed ? record.timestamp - lastTimestamp : 0);
+      Serial.print(",");
+      Serial.println(record.data[0]);
+    }
+    lastTimestamp = record.timestamp;
+    printed++;
+  }
+  if (sampler.getStats().samples < 500) return;
+
+  const SWI2C_SampleStats& s = sampler.getStats();
+  Serial.print("Samples: ");
+  Serial.print(s.samples);
+  Serial.print(", failures: ");
+  Serial.print(s.failures);
+  Serial.print(", overwritten: ");
+  Serial.println(s.overwritten);
+  Serial.print("Interval (us): min ");
+  Serial.print(s.minInterval);
+  Serial.print(", mean ");
+  Serial.print(s.totalInterval / s.intervals);
+  Serial.print(", max ");
+  Serial.println(s.maxInterval);
+  Serial.print("Jitter (us): min ");
+  Serial.print(s.minJitter);
+  Serial.print(", mean ");
+  Serial.print(s.totalJitter / s.jitters);
+  Serial.print(", max ");
+  Serial.println(s.maxJitter);
+  Serial.print("Longest read (us): ");
+  Serial.println(s.maxDuration);
+  done = true;
+}
@@ -0,0 +1,106 @@
+/* -----------------------------------------------------------------
+   SWI2C Scheduler
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Polls registers on two devices at different rates with
+   SWI2CScheduler, then prints the runs, overruns, and jitter of each
+   job after one second:
+     - 0x68 (like the MPU6050): accelerometer and gyro at 1 kHz,
+       temperature at 10 Hz, and a configuration register at 1 Hz
+     - 0x48 (like the TMP102): temperature at 10 Hz
+
+   The accelerometer (0x3B-0x40), temperature (0x41-0x42), and gyro
+   (0x43-0x48) registers are next to each other, so jobs that are due
+   together are read in one burst.
+
+   The devices are simulated (SWI2C_SimBus.h), so no I2C hardware is
+   needed, and time is simulated time. loop() models 200 us of other
+   work on each pass with idle(). With real hardware, use SWI2CBus and
+   SWI2CDevice:
+     SWI2CBus bus(SDA_PIN, SCL_PIN);
+     SWI2CDevice imu(bus, 0x68);
+     SWI2CScheduler<SWI2CDevice, 5> scheduler;
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+#include "SWI2C_Scheduler.h"
+
+SWI2C_SimBus simBus;
+uint8_t imuRegisters[128];
+uint8_t tempRegisters[4];
+SWI2C_SimRegisterDevice imuModel(0x68, imuRegisters, sizeof(imuRegisters));
+SWI2C_SimRegisterDevice tempModel(0x48, tempRegisters, sizeof(tempRegisters));
+
+SWI2CBusSim bus(simBus);
+SWI2CDeviceSim imu(bus, 0x68);
+SWI2CDeviceSim sensor(bus, 0x48);
+
+SWI2CScheduler<SWI2CDeviceSim, 5> scheduler;
+
+uint8_t accel[6];
+uint8_t gyro[6];
+uint8_t imuTemp[2];
+uint8_t config[1];
+uint8_t sensorTemp[2];
+
+const char* jobNames[] = {"accel 1 kHz", "gyro 1 kHz", "imu temp 10 Hz", "config 1 Hz", "sensor temp 10 Hz"};
+
+unsigned long startTime;
+bool done = false;
+
+void setup() {
+  Serial.begin(9600);
+
+  simBus.setPinTiming(250, 250);
+  simBus.attach(imuModel);
+  simBus.attach(tempModel);
+  bus.begin();
+
+  scheduler.addJob(imu, 0x3B, accel, 6, 1000);
+  scheduler.addJob(imu, 0x43, gyro, 6, 1000);
+  scheduler.addJob(imu, 0x41, imuTemp, 2, 100000);
+  scheduler.addJob(imu, 0x1A, config, 1, 1000000);
+  scheduler.addJob(sensor, 0x00, sensorTemp, 2, 100000, 500);   // Offset by half of the 1 kHz period
+  startTime = simBus.getMicros();
+
+  Serial.println("");
+  Serial.println("SWI2C Scheduler.");
+}
+
+void loop() {
+  uint32_t runs = 0;
+  const SWI2C_JobStats* s;
+
+  if (done) return;
+  scheduler.run();
+  simBus.idle(200);   // Other work
+  if (simBus.getMicros() - startTime < 1000000UL) return;
+
+  Serial.println("job,runs,overruns,failures,mean_jitter_us,max_jitter_us");
+  for (uint8_t j = 0; j < 5; j++) {
+    s = &scheduler.getStats(j);
+    Serial.print(jobNames[j]);
+    Serial.print(",");
+    Serial.print(s->runs);
+    Serial.print(",");
+    Serial.print(s->overruns);
+    Serial.print(",");
+    Serial.print(s->failures);
+    Serial.print(",");
+    Serial.print(s->runs ? s->totalLate / s->runs : 0);
+    Serial.print(",");
+    Serial.println(s->maxLate);
+    runs += s->runs;
+  }
+  Serial.print("Job reads: ");
+  Serial.print(runs);
+  Serial.print(", bus transactions: ");
+  Serial.println(scheduler.getReads());
+  done = true;
+}
@@ -0,0 +1,188 @@
+/* -----------------------------------------------------------------
+   SWI2C Simulation
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Add batched transfer()
+   10/16/2026 - Andy4495 - Add register cache
+   10/16/2026 - Andy4495 - Add FIFO drain into a ring buffer
+   10/16/2026 - Andy4495 - Add address scan
+   10/16/2026 - Andy4495 - Add error codes and bus recovery
+   10/16/2026 - Andy4495 - Add scatter-gather write
+*/
+/* -----------------------------------------------------------------
+
+   Runs the SWI2C methods against a simulated I2C bus, so no I2C
+   hardware is needed. The simulated bus has five device models:
+     - 0x68: register-file device (like the MPU6050)
+     - 0x69: device with a FIFO (count at 0x72, data at 0x74, like the MPU6050)
+     - 0x38: device without registers (like the PCF8574)
+     - 0x50: register-file device that stretches the clock
+     - 0x22: device that NACKs after the first byte written
+   Nothing is attached at 0x11.
+
+   For each operation the sketch checks the result and prints the
+   number of pin writes (edges), pin reads (samples), SCL clock
+   pulses, and clock-stretch samples used by that transaction.
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+#include "SWI2C_RegCache.h"
+
+SWI2C_SimBus bus;
+
+uint8_t mpuRegisters[128];
+uint8_t slowRegisters[16];
+SWI2C_SimRegisterDevice mpuModel(0x68, mpuRegisters, sizeof(mpuRegisters));
+SWI2C_SimPortDevice pcfModel(0x38);
+SWI2C_SimRegisterDevice slowModel(0x50, slowRegisters, sizeof(slowRegisters));
+SWI2C_SimDevice nackModel(0x22);
+SWI2C_SimFifoDevice fifoModel(0x69, 0x72, 0x74);
+
+SWI2CSim mpu(bus, 0x68);
+SWI2CSim pcf(bus, 0x38);
+SWI2CSim slow(bus, 0x50);
+SWI2CSim nacker(bus, 0x22);
+SWI2CSim missing(bus, 0x11);
+SWI2CSim fifo(bus, 0x69);
+
+uint8_t ringStorage[65];
+SWI2CRing ring(ringStorage, sizeof(ringStorage));   // Holds 64 bytes
+
+// Configuration registers 0x19-0x1C of the MPU6050 model
+SWI2CRegCache<SWI2CSim, 4> mpuConfig(mpu, 0x19);
+
+// Fixed command prefix for the scatter-gather write, kept in flash
+const uint8_t commandPrefix[3] PROGMEM = {0xC0, 0xC1, 0xC2};
+
+int failures = 0;
+
+void report(const char* operation, bool passed) {
+  const SWI2C_SimBus::Counters& c = bus.getTransactionCounters();
+  Serial.print(operation);
+  Serial.print(",");
+  Serial.print(c.pinWrites);
+  Serial.print(",");
+  Serial.print(c.pinReads);
+  Serial.print(",");
+  Serial.print(c.sclPulses);
+  Serial.print(",");
+  Serial.print(c.stretchReads);
+  Serial.print(",");
+  Serial.println(passed ? "PASS" : "FAIL");
+  if (!passed) failures++;
+}
+
+void setup() {
+  uint8_t data;
+  uint16_t data16;
+  uint8_t buffer[14];
+  uint8_t pattern[14] = {0x10, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87, 0x98, 0xA9, 0xBA, 0xCB, 0xDC, 0xED};
+
+  Serial.begin(9600);
+
+  slowModel.setClockStretch(3);
+  nackModel.setNackAfter(1);
+  bus.attach(mpuModel);
+  bus.attach(pcfModel);
+  bus.attach(slowModel);
+  bus.attach(nackModel);
+  bus.attach(fifoModel);
+  mpu.begin();
+
+  Serial.println("");
+  Serial.println("SWI2C Simulation.");
+  Serial.println("operation,pin_writes,pin_reads,scl_pulses,stretch_reads,result");
+
+  // Register-based device, high level methods
+  report("writeToRegister(1)", mpu.writeToRegister(0x6B, 0x01) == 1 && mpuRegisters[0x6B] == 0x01);
+  report("readFromRegister(1)", mpu.readFromRegister(0x6B, data) == 1 && data == 0x01);
+  report("writeToRegister(14)", mpu.writeToRegister(0x3B, pattern, 14) == 1 && memcmp(&mpuRegisters[0x3B], pattern, 14) == 0);
+  report("readFromRegister(14)", mpu.readFromRegister(0x3B, buffer, 14) == 1 && memcmp(buffer, pattern, 14) == 0);
+  report("write2bToRegister", mpu.write2bToRegister(0x20, 0x1234) == 1 && mpuRegisters[0x20] == 0x34);
+  report("write2bToRegisterMSBFirst", mpu.write2bToRegisterMSBFirst(0x20, 0x1234) == 1 && mpuRegisters[0x20] == 0x12);
+  report("read2bFromRegister", mpu.read2bFromRegister(0x20, &data16) == 1 && data16 == 0x3412);
+  report("read2bFromRegisterMSBFirst", mpu.read2bFromRegisterMSBFirst(0x20, &data16) == 1 && data16 == 0x1234);
+  report("read1bFromRegister", mpu.read1bFromRegister(0x3B, &data) == 1 && data == pattern[0]);
+
+  // Scatter-gather write: a prefix from flash, then the payload from RAM, in one transaction
+  SWI2C_Segment segments[2] = {{commandPrefix, 3, SWI2C_SEG_PROGMEM}, {pattern, 14, 0}};
+  report("writeToRegister(segments)", mpu.writeToRegister(0x50, segments, 2) == 1 && mpuRegisters[0x52] == 0xC2 &&
+         memcmp(&mpuRegisters[0x53], pattern, 14) == 0);
+
+  // Device without registers
+  report("writeToDevice(1)", pcf.writeToDevice(0x5A) == 1 && pcfModel.getPort() == 0x5A);
+  report("readFromDevice(1)", pcf.readFromDevice(data) == 1 && data == 0x5A);
+  report("readFromDevice(3)", pcf.readFromDevice(buffer, 3) == 1 && buffer[2] == 0x5A);
+
+  // Clock stretching
+  report("readFromRegister(4) stretched", slow.readFromRegister(0, buffer, 4) == 1 && slow.checkStretchTimeout() == 0);
+
+  // NACKs
+  report("writeToRegister NACK on data", nacker.writeToRegister(0x01, 0x02) == 0 && nacker.getLastError() == SWI2C_MSG_DATA_NACK);
+  report("readFromRegister NACK on address", missing.readFromRegister(0x01, data) == 0 && missing.getLastError() == SWI2C_MSG_ADDRESS_NACK);
+
+  // Bus recovery: stop clocking part way through a read, as if the
+  // controller had been reset, leaving the device driving SDA low
+  mpuRegisters[0x10] = 0x00;
+  mpuRegisters[0x11] = 0x00;
+  mpu.readFromRegister(0x10, data);   // Register pointer is now 0x11
+  mpu.startBit();
+  mpu.writeAddress(1);
+  mpu.checkAckBit();
+  mpu.sclHi();
+  mpu.sclLo();
+  report("readFromRegister after SDA stuck low", mpu.readFromRegister(0x3B, data) == 1 && data == pattern[0] &&
+         mpu.getLastError() == SWI2C_MSG_OK);
+
+  // Batched transfer: two registers from two devices in one transaction
+  uint8_t regA = 0x3B, regB = 0x20;
+  uint8_t status[4];
+  SWI2C_Msg msgs[4] = {
+    {0x68, 0, 1, &regA}, {0x68, SWI2C_M_RD, 6, buffer},
+    {0x50, 0, 1, &regB}, {0x50, SWI2C_M_RD, 2, &buffer[6]}
+  };
+  slowRegisters[0x20 % sizeof(slowRegisters)] = 0xC3;
+  report("transfer(4 messages)", mpu.transfer(msgs, 4, status) == 4 && memcmp(buffer, pattern, 6) == 0 && buffer[6] == 0xC3);
+  msgs[2].addr = 0x11;
+  report("transfer NACK on address", mpu.transfer(msgs, 4, status) == 2 && status[2] == SWI2C_MSG_ADDRESS_NACK && status[3] == SWI2C_MSG_NOT_SENT);
+
+  // Register cache: read-modify-write of two registers, then one burst write
+  unsigned long transactions;
+  mpuConfig.setCacheable(0x19, 4);
+  mpuRegisters[0x1A] = 0x40;
+  mpuRegisters[0x1B] = 0x00;
+  transactions = bus.getCounters().transactions;
+  report("cache updateBits (first read)", mpuConfig.updateBits(0x1A, 0x07, 0x03) == 1 && mpuRegisters[0x1A] == 0x40);
+  report("cache updateBits (cached)", mpuConfig.updateBits(0x1A, 0x38, 0x08) == 1 && bus.getCounters().transactions - transactions == 2);
+  mpuConfig.updateBits(0x1B, 0x18, 0x10);
+  report("cache flush", mpuConfig.flush() == 1 && mpuRegisters[0x1A] == 0x4B && mpuRegisters[0x1B] == 0x10 &&
+         bus.getCounters().transactions - transactions == 5);
+
+  // FIFO: 100 bytes waiting, but the ring only has space for 64
+  fifoModel.fill(100);
+  report("drainFIFO (ring full)", fifo.drainFIFO(0x72, 0x74, ring) == 64 && fifoModel.getCount() == 36 && ring.read() == 0);
+  for (uint8_t i = 1; i < 64; i++) ring.read();
+  report("drainFIFO (rest)", fifo.drainFIFO(0x72, 0x74, ring) == 36 && fifoModel.getCount() == 0 && ring.read() == 64);
+
+  // Address scan: all five device models, then detect one that stops responding
+  SWI2C_ScanMap devices;
+  report("scan", mpu.scan(devices) == 5 && devices.isPresent(0x22) && !devices.isPresent(0x11));
+  pcfModel.setNackAddress(true);
+  report("rescan (device removed)", mpu.rescan(devices, SWI2C_RESCAN_PRESENT) == 1 && devices.isChanged(0x38));
+  pcfModel.setNackAddress(false);
+
+  // Low level methods: address probe
+  missing.startBit();
+  missing.writeAddress(0);
+  data = missing.checkAckBit();
+  missing.stopBit();
+  report("address probe (absent)", data == 1);
+
+  Serial.println(failures ? "FAILED" : "All operations passed.");
+}
+
+void loop() {
+}
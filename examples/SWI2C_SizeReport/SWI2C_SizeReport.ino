@@ -0,0 +1,45 @@
+/* -----------------------------------------------------------------
+   SWI2C Size Report
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   A typical small sensor sketch: one device, a few register writes
+   during setup, and a burst read in loop(). It is compiled by
+   extras/size_report.sh once for each SWI2C_Config.h configuration,
+   to show the flash and RAM used by each:
+
+     extras/size_report.sh arduino:avr:uno
+
+   It only uses methods that are available in every configuration.
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C.h"
+
+#define SDA_PIN         3
+#define SCL_PIN         2
+#define DEVICE_ADDRESS  0x68
+
+SWI2C myDevice(SDA_PIN, SCL_PIN, DEVICE_ADDRESS);
+uint8_t sample[6];
+
+void setup() {
+  uint8_t id;
+
+  myDevice.begin();
+  myDevice.writeToRegister(0x6B, 0x01);
+  if (myDevice.readFromRegister(0x75, id)) {
+    myDevice.writeToRegister(0x1B, 0x18);
+  }
+}
+
+void loop() {
+  if (myDevice.readFromRegister(0x3B, sample, sizeof(sample)) == 0) {
+    myDevice.recover();
+  }
+  delay(100);
+}
@@ -0,0 +1,130 @@
+/* -----------------------------------------------------------------
+   SWI2C Target
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Runs the SWI2CTarget code (the target side, as on a secondary
+   microcontroller that must look like an I2C peripheral) against the
+   SWI2C controller code, and measures the fastest clock the target
+   keeps up with.
+
+   The target's pin-change interrupt handler starts targetLatencyNs
+   after each edge, and each of its pin operations takes targetPinNs.
+   For each controller speed, from slow to fast, the controller writes
+   4 registers and reads them back 20 times. Each line shows:
+     - pin_ns:     simulated time of each controller pin operation
+     - scl_khz:    clock rate, including any clock stretching
+     - errors:     writes or reads that failed or read back wrong data
+     - late:       bits the target put on SDA after SCL had risen
+     - glitches:   extra clock pulses from the target holding SCL too late
+     - stretch_ns: time per byte that the target held SCL low after the
+                   controller released it
+   The target keeps up at a speed if all four counts are 0. The fastest
+   such speed is printed at the end.
+
+   The controller, the target, and the bus are simulated
+   (SWI2C_SimBus.h), so no I2C hardware is needed. With real hardware,
+   use SWI2CTarget on the secondary microcontroller:
+     SWI2CTarget target(SDA_PIN, SCL_PIN, 0x42);
+     void onPinChange() {target.onPinChange();}
+     ...
+     attachInterrupt(digitalPinToInterrupt(SDA_PIN), onPinChange, CHANGE);
+     attachInterrupt(digitalPinToInterrupt(SCL_PIN), onPinChange, CHANGE);
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+
+#define TARGET_ADDRESS 0x42
+
+// Target timing (ns)
+const unsigned int targetLatencyNs = 2000;
+const unsigned int targetPinNs = 250;
+
+SWI2C_SimBus simBus;
+SWI2CBusSim bus(simBus);
+SWI2CDeviceSim peripheral(bus, TARGET_ADDRESS);
+
+uint8_t registers[32];
+SWI2CTargetSim target(simBus, TARGET_ADDRESS);
+
+unsigned int pinNs = 5000;
+unsigned long writesReported = 0;
+unsigned long fastestKHz = 0;
+bool done = false;
+
+void onPinChange() {
+  target.onPinChange();
+}
+
+void onWrite(uint8_t regAddress, uint8_t count) {
+  (void)regAddress;
+  (void)count;
+  writesReported++;
+}
+
+void setup() {
+  Serial.begin(9600);
+
+  target.setRegisters(registers, sizeof(registers));
+  target.setWriteCallback(onWrite);
+  simBus.setTarget(onPinChange, targetLatencyNs, targetPinNs);
+  target.begin();
+  bus.begin();
+
+  Serial.println("");
+  Serial.println("SWI2C Target.");
+  Serial.println("pin_ns,scl_khz,errors,late,glitches,stretch_ns");
+}
+
+void loop() {
+  const uint8_t passes = 20;
+  const uint8_t bytesPerPass = 13;   // Write: address, register, 4 data. Read: 2 addresses, register, 4 data.
+  uint8_t data[4];
+  uint8_t readBack[4];
+  unsigned int errors = 0;
+  unsigned long khz;
+
+  if (done) return;
+  simBus.setPinTiming(pinNs, pinNs);
+  simBus.resetCounters();
+  target.resetStats();
+  for (uint8_t i = 0; i < passes; i++) {
+    data[0] = i;
+    data[1] = i * 3;
+    data[2] = ~i;
+    data[3] = 0xA5;
+    if (!peripheral.writeToRegister(i, data, 4) || !peripheral.readFromRegister(i, readBack, 4) ||
+        memcmp(data, readBack, 4) != 0) errors++;
+    simBus.idle(20);
+  }
+
+  const SWI2C_SimBus::Counters& c = simBus.getCounters();
+  khz = c.busTime ? (c.sclPulses - c.targetGlitches) * 1000 / c.busTime : 0;
+  Serial.print(pinNs);
+  Serial.print(",");
+  Serial.print(khz);
+  Serial.print(",");
+  Serial.print(errors);
+  Serial.print(",");
+  Serial.print(target.getStats().late);
+  Serial.print(",");
+  Serial.print(c.targetGlitches);
+  Serial.print(",");
+  Serial.println(c.targetStretch / (passes * bytesPerPass));
+  if (errors == 0 && target.getStats().late == 0 && c.targetGlitches == 0 && khz > fastestKHz) fastestKHz = khz;
+
+  pinNs = pinNs * 4 / 5;
+  if (pinNs >= 200) return;
+
+  Serial.print("Fastest clock with no errors: ");
+  Serial.print(fastestKHz);
+  Serial.println(" kHz");
+  Serial.print("Writes reported by the target: ");
+  Serial.println(writesReported);
+  done = true;
+}
@@ -0,0 +1,72 @@
+/* -----------------------------------------------------------------
+   SWI2C Trace
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+
+   Records the SDA and SCL edges of a few transactions on a simulated
+   I2C bus, then prints:
+     - the decoded protocol events (START, address, data, ACK/NACK,
+       clock stretches, STOP) with their times in us
+     - a Value Change Dump (VCD) of both lines. Copy the lines from
+       "$timescale" to the end into a .vcd file and open it with GTKWave.
+
+   The simulated bus has two device models:
+     - 0x68: register-file device (like the MPU6050)
+     - 0x50: register-file device that stretches the clock
+
+   To trace a real bus instead, replace the simulated bus and devices with:
+     SWI2CBusTrace traceBus(SDA_PIN, SCL_PIN, trace);
+     SWI2CDeviceTrace mpu(traceBus, 0x68);
+
+   -----------------------------------------------------------------
+*/
+#include "SWI2C_SimBus.h"
+
+SWI2C_SimBus bus;
+
+uint8_t mpuRegisters[128];
+uint8_t slowRegisters[16];
+SWI2C_SimRegisterDevice mpuModel(0x68, mpuRegisters, sizeof(mpuRegisters));
+SWI2C_SimRegisterDevice slowModel(0x50, slowRegisters, sizeof(slowRegisters));
+
+SWI2C_TraceEvent events[400];
+SWI2C_Trace trace(events, sizeof(events) / sizeof(events[0]));
+
+SWI2CBusSimTrace traceBus(bus, trace);
+SWI2CDeviceSimTrace mpu(traceBus, 0x68);
+SWI2CDeviceSimTrace slow(traceBus, 0x50);
+
+void setup() {
+  uint8_t data;
+  uint8_t buffer[2];
+
+  Serial.begin(9600);
+
+  slowModel.setClockStretch(3);
+  slowRegisters[0] = 0xA5;
+  slowRegisters[1] = 0x3C;
+  bus.attach(mpuModel);
+  bus.attach(slowModel);
+  traceBus.begin();
+  trace.clear();
+
+  mpu.writeToRegister(0x6B, 0x01);
+  mpu.readFromRegister(0x6B, data);
+  slow.readFromRegister(0x00, buffer, 2);
+
+  Serial.println("");
+  Serial.println("SWI2C Trace.");
+  Serial.print("Events recorded: ");
+  Serial.println(trace.getCount());
+  Serial.println("");
+  trace.printEvents(Serial);
+  Serial.println("");
+  trace.printVCD(Serial);
+}
+
+void loop() {
+}
@@ -0,0 +1,92 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Host build stub for the Arduino core
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+
+#include <time.h>
+#include "Arduino.h"
+
+HardwareSerial Serial;
+HostCounters hostCounters;
+
+enum {HOST_PINS = 256};
+static uint8_t pinModes[HOST_PINS];
+static uint8_t pinLatches[HOST_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  hostCounters.pinModes++;
+  pinModes[pin] = mode;
+}
+
+int digitalRead(uint8_t pin) {
+  // Open-drain line with a pull-up: LOW only while driven low
+  hostCounters.digitalReads++;
+  return (pinModes[pin] == OUTPUT && pinLatches[pin] == LOW) ? LOW : HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  hostCounters.digitalWrites++;
+  pinLatches[pin] = value;
+}
+
+unsigned long micros() {
+  struct timespec ts;
+  hostCounters.timeReads++;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long)ts.tv_sec * 1000000UL + ts.tv_nsec / 1000;
+}
+
+unsigned long millis() {
+  return micros() / 1000;
+}
+
+void delay(unsigned long ms) {
+  unsigned long start = millis();
+  while (millis() - start < ms) ;  // Empty statement: wait
+}
+
+void delayMicroseconds(unsigned int us) {
+  unsigned long start = micros();
+  while (micros() - start < us) ;  // Empty statement: wait
+}
+
+void hostResetCounters() {
+  memset(&hostCounters, 0, sizeof(hostCounters));
+}
+
+size_t Print::write(uint8_t c) {
+  return (fputc(c, stdout) == EOF) ? 0 : 1;
+}
+
+size_t Print::print(const char* s) {
+  size_t n = 0;
+  while (*s) n += write(*s++);
+  return n;
+}
+
+size_t Print::print(unsigned long n, int base) {
+  char digits[8 * sizeof(n) + 1];
+  uint8_t i = sizeof(digits) - 1;
+  digits[i] = 0;
+  if (base < 2) base = DEC;
+  do {
+    uint8_t digit = n % base;
+    digits[--i] = (digit < 10) ? '0' + digit : 'A' + digit - 10;
+    n /= base;
+  } while (n);
+  return print(digits + i);
+}
+
+size_t Print::print(long n, int base) {
+  if (base == DEC && n < 0) return print('-') + print(0UL - (unsigned long)n, base);
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(double n, int digits) {
+  char text[64];
+  snprintf(text, sizeof(text), "%.*f", digits, n);
+  return print(text);
+}
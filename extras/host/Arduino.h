@@ -0,0 +1,97 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Host build stub for Arduino.h
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   The parts of the Arduino API used by the library and its examples,
+   so that they can be built and tested on a Linux host (see Makefile).
+
+   The pins are open-drain lines with pull-up resistors and nothing else
+   attached: a pin reads LOW only while it is an OUTPUT with its output
+   latch LOW. millis() and micros() return the host's monotonic clock.
+   Serial prints to stdout.
+
+   Each call is counted in hostCounters, so tests and benchmarks can
+   report the Arduino calls made by an operation.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_HOST_ARDUINO_H
+#define SWI2C_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define DEC 10
+#define HEX 16
+#define BIN 2
+#define PROGMEM
+#define F(s) (s)
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline int digitalPinToInterrupt(uint8_t pin) {return pin;}
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void interrupts() {}
+inline void noInterrupts() {}
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c);
+  size_t print(const char* s);
+  size_t print(char c) {return write(c);}
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(long n, int base = DEC);
+  size_t print(unsigned int n, int base = DEC) {return print((unsigned long)n, base);}
+  size_t print(int n, int base = DEC) {return print((long)n, base);}
+  size_t print(unsigned char n, int base = DEC) {return print((unsigned long)n, base);}
+  size_t print(double n, int digits = 2);
+  size_t println() {return print("\r\n");}
+  template <class T> size_t println(T value) {size_t n = print(value); return n + println();}
+  template <class T> size_t println(T value, int format) {size_t n = print(value, format); return n + println();}
+};
+
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  operator bool() {return true;}
+  int available() {return 0;}
+  int read() {return -1;}
+};
+
+extern HardwareSerial Serial;
+
+// Host only: Arduino calls made since hostResetCounters()
+struct HostCounters {
+  unsigned long pinModes;
+  unsigned long digitalReads;
+  unsigned long digitalWrites;
+  unsigned long timeReads;      // millis() and micros()
+};
+
+extern HostCounters hostCounters;
+void hostResetCounters();
+
+#endif
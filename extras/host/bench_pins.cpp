@@ -0,0 +1,103 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Host benchmark of SWI2C and SWI2CT
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   Host version of the SWI2C_Benchmark example. Repeats each low level
+   operation and prints, for runtime pins (SWI2C) and compile-time pins
+   (SWI2CT), the host time and CPU cycles (time stamp counter, x86 only)
+   per call, and the Arduino pin calls per call.
+
+   The host uses the portable Arduino pin driver, so this measures the
+   overhead of the core around the pin calls, not the AVR port access.
+   -----------------------------------------------------------------
+*/
+
+#include <time.h>
+#include "SWI2C.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HOST_CYCLES() __rdtsc()
+#else
+#define HOST_CYCLES() 0ULL
+#endif
+
+#define SDA_PIN 10
+#define SCL_PIN 9
+
+const unsigned long iterations = 200000;
+
+static unsigned long long nanoseconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+struct Timer {
+  unsigned long long ns;
+  unsigned long long cycles;
+  void start() {
+    hostResetCounters();
+    ns = nanoseconds();
+    cycles = HOST_CYCLES();
+  }
+  void print(const char* variant, const char* operation) {
+    unsigned long long elapsedCycles = HOST_CYCLES() - cycles;
+    unsigned long long elapsedNs = nanoseconds() - ns;
+    printf("%-6s %-18s %8.1f ns %8.1f cycles %6.2f pin calls\n", variant, operation,
+           (double)elapsedNs / iterations, (double)elapsedCycles / iterations,
+           (double)(hostCounters.pinModes + hostCounters.digitalReads) / iterations);
+  }
+};
+
+// Template so both variants are measured with identical code
+template <class DEVICE>
+void runBenchmark(DEVICE& device, const char* variant) {
+  Timer timer;
+  volatile uint8_t value;
+
+  device.begin();
+  timer.start();
+  for (unsigned long i = 0; i < iterations; i++) {
+    device.sdaLo();
+    device.sdaHi();
+  }
+  timer.print(variant, "sdaLo+sdaHi");
+
+  timer.start();
+  for (unsigned long i = 0; i < iterations; i++) {
+    device.sclLo();
+    device.sclHi();
+  }
+  timer.print(variant, "sclLo+sclHi");
+
+  device.startBit();
+  timer.start();
+  for (unsigned long i = 0; i < iterations; i++) {
+    device.writeByte(0x55);
+    device.sclHi();    // Stand-in for the ACK clock
+    device.sclLo();
+  }
+  timer.print(variant, "writeByte");
+
+  timer.start();
+  for (unsigned long i = 0; i < iterations; i++) {
+    value = device.read1Byte();
+    device.writeAck();
+  }
+  timer.print(variant, "read1Byte+writeAck");
+  device.stopBit();
+  (void)value;
+}
+
+int main() {
+  SWI2C runtimePins(SDA_PIN, SCL_PIN, 0x68);
+  SWI2CT<SDA_PIN, SCL_PIN> fixedPins(0x68);
+
+  runBenchmark(runtimePins, "SWI2C");
+  runBenchmark(fixedPins, "SWI2CT");
+  return 0;
+}
@@ -0,0 +1,39 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Host test checks
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   CHECK(condition) records a failure, with its file and line, if the
+   condition is false, and the test goes on. Each test program runs its
+   tests with RUN(test), and returns testResult() from main(): 0 if all
+   checks passed.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_HOST_TEST_H
+#define SWI2C_HOST_TEST_H
+
+#include <stdio.h>
+
+static unsigned int testChecks;
+static unsigned int testFailures;
+
+static void testCheck(bool ok, const char* expression, const char* file, int line) {
+  testChecks++;
+  if (ok) return;
+  testFailures++;
+  printf("%s:%d: CHECK(%s) failed\n", file, line, expression);
+}
+
+#define CHECK(condition) testCheck((condition), #condition, __FILE__, __LINE__)
+#define RUN(test) do {printf("%s\n", #test); test();} while (0)
+
+static int testResult() {
+  printf("%u checks, %u failed\n", testChecks, testFailures);
+  return testFailures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,120 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Host test of the bus lock from interrupt handlers
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   Built without the compiler's lock-free atomics, so the bus lock is
+   the plain check and set of the lock byte, and the lock statistics are
+   plain adds, as on processors without atomic operations (see
+   SWI2C_Lock.h). Simulated interrupts (see SWI2C_SimBus.h) make
+   requests and take the lock part way through the transactions of the
+   code they interrupt, and while the bus is free.
+   -----------------------------------------------------------------
+*/
+
+#include "SWI2C_SimBus.h"
+#include "test.h"
+
+#if defined(__GCC_ATOMIC_BOOL_LOCK_FREE)
+#error "test_lock is built without the lock-free atomics (see Makefile)"
+#endif
+
+static SWI2C_SimBus simBus;
+static uint8_t registers[128];
+static SWI2C_SimRegisterDevice mpu(0x68, registers, sizeof(registers));
+static SWI2CBusSim bus(simBus);
+static SWI2CDeviceSim imu(bus, 0x68);
+static SWI2C_Request entries[4];
+static SWI2C_RequestQueue queue(entries, 4);
+static uint8_t sample[2];
+static unsigned long handlerCalls;
+static unsigned long handlerAcquired;
+static unsigned long callbacks;
+static unsigned long failures;
+
+static void onTryAcquire() {
+  handlerCalls++;
+  if (bus.tryAcquire()) {
+    handlerAcquired++;
+    bus.release();
+  }
+}
+
+static void testTryAcquireInHandler() {
+  // The handler's check of the lock sees the bus owned by the code it
+  // interrupted, and leaves it owned
+  queue.resetStats();
+  handlerCalls = 0;
+  handlerAcquired = 0;
+  CHECK(bus.tryAcquire());
+  simBus.setInterrupt(onTryAcquire, 0, 10);
+  simBus.idle(100);
+  CHECK(handlerCalls == 1 && handlerAcquired == 0);
+  CHECK(bus.isBusy());
+  bus.release();
+  CHECK(!bus.isBusy());
+
+  simBus.setInterrupt(onTryAcquire, 0, 10);
+  simBus.idle(100);
+  CHECK(handlerCalls == 2 && handlerAcquired == 1);
+  CHECK(!bus.isBusy());
+  CHECK(queue.getStats().acquisitions == 2 && queue.getStats().contentions == 0);
+  simBus.setInterrupt(0, 0, 0);
+}
+
+static void onSample(void*, int result) {
+  callbacks++;
+  if (result != 1) failures++;
+}
+
+static void onDataReady() {
+  handlerCalls++;
+  imu.requestFromRegister(0x10, sample, 2, onSample);
+}
+
+static void testRequestsDuringTransactions() {
+  // Requests from a periodic interrupt, some made part way through a
+  // transaction and queued, some made while the bus is free and run
+  // right away. Each runs once, and the statistics add up.
+  uint8_t value = 0;
+  unsigned int reads = 0;
+
+  queue.resetStats();
+  handlerCalls = 0;
+  callbacks = 0;
+  failures = 0;
+  registers[0x10] = 0x5A;
+  registers[0x20] = 0xA5;
+  simBus.setInterrupt(onDataReady, 230, 5);
+  for (uint8_t i = 0; i < 50; i++) {
+    if (imu.readFromRegister(0x20, value) == 1 && value == 0xA5) reads++;
+    simBus.idle(100);
+  }
+  simBus.setInterrupt(0, 0, 0);
+
+  const SWI2C_LockStats& stats = queue.getStats();
+  CHECK(reads == 50);
+  CHECK(handlerCalls > 0 && stats.requests == handlerCalls);
+  CHECK(stats.queued > 0 && stats.queued < stats.requests);
+  CHECK(stats.dropped == 0);
+  CHECK(callbacks == stats.requests && failures == 0);
+  CHECK(sample[0] == 0x5A);
+  // The owner never waits for a handler, and a queued request runs under
+  // the owner's lock
+  CHECK(stats.contentions == 0);
+  CHECK(stats.acquisitions == reads + stats.requests - stats.queued);
+  CHECK(!bus.isBusy());
+}
+
+int main() {
+  simBus.attach(mpu);
+  bus.setRequestQueue(&queue);
+  imu.begin();
+
+  RUN(testTryAcquireInHandler);
+  RUN(testRequestsDuringTransactions);
+  return testResult();
+}
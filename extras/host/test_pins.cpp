@@ -0,0 +1,172 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Host test of the edge sequence
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   Built with SWI2C_PIN_DRIVER_CUSTOM (see SWI2C_PinDriver.h). The
+   SWI2C_pin*() functions below are a mock pin driver: two open-drain
+   lines with pull-ups and no device, which log every change of level.
+   The log is decoded back into START, bytes, ACK bits, and STOP, which
+   checks that SDA only changes while SCL is low (except for START and
+   STOP) and that the bits are right. The mock also counts pin writes
+   that do not change the line, which the tracked line state should
+   avoid on SDA. The host time source checks that SWI2CAsync keeps the
+   bus speed.
+   -----------------------------------------------------------------
+*/
+
+#include "SWI2C.h"
+#include "SWI2C_Async.h"
+#include "test.h"
+
+#define SDA_PIN 4
+#define SCL_PIN 5
+
+struct Edge {
+  uint8_t pin;
+  uint8_t level;
+};
+
+enum {MAX_EDGES = 512};
+static Edge edges[MAX_EDGES];
+static unsigned int edgeCount;
+static unsigned int redundantSda;
+static uint8_t low[2];
+
+static uint8_t line(uint8_t pin) {return pin == SDA_PIN ? 0 : 1;}
+
+static void setLevel(uint8_t pin, uint8_t isLow) {
+  if (low[line(pin)] == isLow) {
+    if (pin == SDA_PIN) redundantSda++;
+    return;
+  }
+  low[line(pin)] = isLow;
+  if (edgeCount < MAX_EDGES) {
+    edges[edgeCount].pin = pin;
+    edges[edgeCount].level = isLow ? LOW : HIGH;
+    edgeCount++;
+  }
+}
+
+void SWI2C_pinBegin(uint8_t pin) {low[line(pin)] = 0;}
+void SWI2C_pinRelease(uint8_t pin) {setLevel(pin, 0);}
+void SWI2C_pinDriveLow(uint8_t pin) {setLevel(pin, 1);}
+uint8_t SWI2C_pinRead(uint8_t pin) {return low[line(pin)] ? LOW : HIGH;}
+
+static void clearLog() {
+  edgeCount = 0;
+  redundantSda = 0;
+}
+
+// Decodes the log into text: S (START), P (STOP), each byte as two hex
+// digits followed by A (ACK) or N (NACK). Returns false if SDA changed
+// while SCL was high other than as a START or STOP.
+static bool decode(char* text, unsigned int size) {
+  uint8_t sda = HIGH, scl = HIGH;
+  uint8_t bits = 0;
+  uint16_t shift = 0;
+  unsigned int n = 0;
+  text[0] = 0;
+
+  for (unsigned int i = 0; i < edgeCount; i++) {
+    if (edges[i].pin == SDA_PIN) {
+      sda = edges[i].level;
+      if (scl == LOW) continue;
+      n += snprintf(text + n, size - n, "%s", sda == LOW ? "S" : "P");
+      bits = 0;
+      shift = 0;
+    }
+    else {
+      scl = edges[i].level;
+      if (scl == LOW) continue;
+      shift = (shift << 1) | sda;
+      if (++bits == 9) {
+        n += snprintf(text + n, size - n, "%02X%c", shift >> 1, (shift & 1) ? 'N' : 'A');
+        bits = 0;
+        shift = 0;
+      }
+    }
+    if (n >= size) return false;
+  }
+  return bits == 0;
+}
+
+static void testLowLevelSequence() {
+  SWI2C device(SDA_PIN, SCL_PIN, 0x68);
+  char text[64];
+
+  device.begin();
+  clearLog();
+  device.startBit();
+  device.writeAddress(0);
+  device.checkAckBit();   // No device, so NACK
+  device.startBit();
+  device.writeByte(0x5A);
+  device.checkAckBit();
+  device.stopBit();
+  CHECK(decode(text, sizeof(text)));
+  CHECK(strcmp(text, "SD0NS5ANP") == 0);
+  CHECK(redundantSda == 0);
+  printf("  %s: %u edges\n", text, edgeCount);
+}
+
+static void testHighLevelSequence() {
+  SWI2CT<SDA_PIN, SCL_PIN> device(0x3C);
+  char text[64];
+
+  device.begin();
+  clearLog();
+  CHECK(device.writeToRegister(0x10, 0x20) == 0);   // No device: NACK, then STOP
+  CHECK(decode(text, sizeof(text)));
+  CHECK(strcmp(text, "S78NP") == 0);
+  CHECK(redundantSda == 0);
+  printf("  %s: %u edges\n", text, edgeCount);
+}
+
+static unsigned long asyncMicros(SWI2CBus& bus, uint8_t* result) {
+  // Time for a non-blocking write of one byte to an absent device
+  SWI2CAsync async(bus);
+  uint8_t data = 0x20;
+  SWI2C_Msg msg = {0x3C, 0, 1, &data};
+  unsigned long start;
+
+  clearLog();
+  start = micros();
+  if (!async.startTransfer(&msg, 1)) return 0;
+  while (async.poll()) ;
+  *result = bus.getLastError();
+  return micros() - start;
+}
+
+static void testAsyncSpeed() {
+  // The async engine keeps the SCL low and high periods of the bus speed
+  SWI2CBus bus(SDA_PIN, SCL_PIN);
+  uint8_t result = SWI2C_MSG_OK;
+  unsigned long maxSpeed;
+  unsigned long standard;
+  char text[64];
+
+  bus.begin();
+  maxSpeed = asyncMicros(bus, &result);
+  CHECK(result == SWI2C_MSG_ADDRESS_NACK);
+  CHECK(decode(text, sizeof(text)) && strcmp(text, "S78NP") == 0);
+  bus.setSpeed(SWI2C_SPEED_STANDARD);
+  bus.begin();
+  result = SWI2C_MSG_OK;
+  standard = asyncMicros(bus, &result);
+  CHECK(result == SWI2C_MSG_ADDRESS_NACK);
+  CHECK(decode(text, sizeof(text)) && strcmp(text, "S78NP") == 0);
+  CHECK(standard >= 9 * 9);   // 9 clocks at no more than 100 kHz, with some margin
+  CHECK(standard > maxSpeed);
+  printf("  %s: %lu us at max speed, %lu us at 100 kHz\n", text, maxSpeed, standard);
+}
+
+int main() {
+  RUN(testLowLevelSequence);
+  RUN(testHighLevelSequence);
+  RUN(testAsyncSpeed);
+  return testResult();
+}
@@ -0,0 +1,659 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Host tests on the simulated bus
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   Runs the high level and low level methods of SWI2CSim (the same code
+   as SWI2C, see SWI2C_SimBus.h) against the simulated device models:
+   a register-file device (MPU6050), a device without registers
+   (PCF8574), a device that stretches the clock, and a device that NACKs.
+   Prints the pin writes (edges) and pin reads of each transaction.
+   -----------------------------------------------------------------
+*/
+
+#include "SWI2C_SimBus.h"
+#include "SWI2C_EEPROM.h"
+#include "SWI2C_SMBus.h"
+#include "SWI2C_Scheduler.h"
+#include "SWI2C_Sampler.h"
+#include "test.h"
+
+static SWI2C_SimBus simBus;
+static uint8_t registers[128];
+static uint8_t slowRegisters[16];
+static SWI2C_SimRegisterDevice mpu(0x68, registers, sizeof(registers));
+static SWI2C_SimPortDevice pcf(0x38);
+static SWI2C_SimRegisterDevice slow(0x48, slowRegisters, sizeof(slowRegisters));
+static SWI2C_SimRegisterDevice nacker(0x50, slowRegisters, sizeof(slowRegisters));
+
+// FIFO device that NACKs its address a set number of times
+class FlakyFifo : public SWI2C_SimFifoDevice {
+public:
+  FlakyFifo(uint8_t address) : SWI2C_SimFifoDevice(address, 0x72, 0x74), nacks(0) {}
+  virtual uint8_t onAddress(uint8_t r_w) {
+    if (nacks) {
+      nacks--;
+      return 0;
+    }
+    return SWI2C_SimFifoDevice::onAddress(r_w);
+  }
+  uint8_t nacks;
+};
+static FlakyFifo fifo(0x69);
+
+static SWI2CSim mpuDevice(simBus, 0x68);
+static SWI2CSim pcfDevice(simBus, 0x38);
+static SWI2CSim slowDevice(simBus, 0x48);
+static SWI2CSim nackDevice(simBus, 0x50);
+static SWI2CSim absentDevice(simBus, 0x20);
+static SWI2CSim fifoDevice(simBus, 0x69);
+
+static void report(const char* name) {
+  const SWI2C_SimBus::Counters& c = simBus.getTransactionCounters();
+  printf("  %-28s edges %3lu  reads %3lu\n", name, c.pinWrites, c.pinReads);
+}
+
+static void testRegisterDevice() {
+  uint8_t data[6] = {1, 2, 3, 4, 5, 6};
+  uint8_t readBack[6];
+  uint8_t value = 0;
+
+  CHECK(mpuDevice.writeToRegister(0x6B, 0x01) == 1);
+  report("writeToRegister(1)");
+  CHECK(registers[0x6B] == 0x01);
+  CHECK(mpuDevice.readFromRegister(0x6B, value) == 1);
+  report("readFromRegister(1)");
+  CHECK(value == 0x01);
+  CHECK(mpuDevice.writeToRegister(0x10, data, 6) == 1);
+  report("writeToRegister(6)");
+  CHECK(memcmp(registers + 0x10, data, 6) == 0);
+  CHECK(mpuDevice.readFromRegister(0x10, readBack, 6) == 1);
+  report("readFromRegister(6)");
+  CHECK(memcmp(readBack, data, 6) == 0);
+  CHECK(mpuDevice.getLastError() == SWI2C_MSG_OK);
+}
+
+static void testLegacyMethods() {
+  uint16_t word = 0;
+  uint8_t data[3] = {7, 8, 9};
+  uint8_t readBack[3];
+  uint8_t value = 0;
+
+  CHECK(mpuDevice.write2bToRegister(0x20, 0x1234) == 1);
+  CHECK(registers[0x20] == 0x34 && registers[0x21] == 0x12);
+  CHECK(mpuDevice.read2bFromRegister(0x20, &word) == 1);
+  report("read2bFromRegister");
+  CHECK(word == 0x1234);
+  CHECK(mpuDevice.write2bToRegisterMSBFirst(0x20, 0x1234) == 1);
+  CHECK(registers[0x20] == 0x12 && registers[0x21] == 0x34);
+  CHECK(mpuDevice.read2bFromRegisterMSBFirst(0x20, &word) == 1);
+  report("read2bFromRegisterMSBFirst");
+  CHECK(word == 0x1234);
+  CHECK(mpuDevice.write1bToRegister(0x22, 0x5A) == 1);
+  CHECK(mpuDevice.read1bFromRegister(0x22, &value) == 1 && value == 0x5A);
+  CHECK(mpuDevice.writeBytesToRegister(0x24, data, 3) == 1);
+  CHECK(mpuDevice.readBytesFromRegister(0x24, readBack, 3) == 1);
+  CHECK(memcmp(readBack, data, 3) == 0);
+}
+
+static void testRingSize() {
+  // A ring with no storage is always full, instead of underflowing space()
+  SWI2CRing empty(0, 0);
+  uint8_t storage[2];
+  SWI2CRing small(storage, sizeof(storage));
+
+  CHECK(empty.space() == 0 && empty.available() == 0);
+  CHECK(!empty.write(1));
+  CHECK(empty.read() == -1);
+  CHECK(mpuDevice.streamFromRegister(0x10, empty, 4) == 0);
+  CHECK(small.space() == 1 && small.write(7) && !small.write(8));
+  CHECK(small.read() == 7 && small.space() == 1);
+}
+
+static void testSamplerSize() {
+  // A sampler of size 0 keeps one record, instead of writing past the array
+  SWI2C_Sample<2> records[2];
+  SWI2C_Sample<2> record;
+  SWI2CSampler<SWI2CSim, 2> sampler(mpuDevice, 0x30, records, 0);
+
+  records[1].data[0] = 0xEE;
+  registers[0x30] = 0x21;
+  CHECK(sampler.sample() == 1);
+  registers[0x30] = 0x22;
+  CHECK(sampler.sample() == 1);
+  CHECK(sampler.available() == 1 && sampler.getStats().overwritten == 1);
+  CHECK(sampler.latest().data[0] == 0x22);
+  CHECK(sampler.take(record) && record.data[0] == 0x22);
+  CHECK(!sampler.take(record));
+  CHECK(records[1].data[0] == 0xEE);
+}
+
+static void testTypedRegisters() {
+  // Typed reads assemble the value from the bytes as they are received
+  typedef SWI2C_Reg<0x40, 24, SWI2C_MSB_FIRST, true> SIGNED24;
+  typedef SWI2C_Reg<0x40, 32, SWI2C_LSB_FIRST> UNSIGNED32;
+  typedef SWI2C_Reg<0x72, 16, SWI2C_MSB_FIRST, false, SWI2C_RO> FIFO_COUNT;
+  int32_t signedValue = 0;
+  uint32_t unsignedValue = 0;
+  uint16_t count = 0;
+  uint8_t ringBuffer[8];
+  SWI2CRing ring(ringBuffer, sizeof(ringBuffer));
+
+  registers[0x40] = 0xFE;
+  registers[0x41] = 0xDC;
+  registers[0x42] = 0xBA;
+  registers[0x43] = 0x98;
+  CHECK(mpuDevice.read<SIGNED24>(signedValue) == 1);
+  report("read<SIGNED24>");
+  CHECK(signedValue == (int32_t)0xFFFEDCBA);
+  CHECK(mpuDevice.read<UNSIGNED32>(unsignedValue) == 1);
+  CHECK(unsignedValue == 0x98BADCFEUL);
+
+  // A retried read returns only the value of the successful attempt
+  fifoDevice.setRetry(2);
+  fifo.fill(5);
+  fifo.nacks = 1;
+  CHECK(fifoDevice.read<FIFO_COUNT>(count) == 1 && count == 5);
+  CHECK(fifoDevice.getAttempts() == 2);
+  fifo.nacks = 2;
+  count = 0x1234;
+  CHECK(fifoDevice.read<FIFO_COUNT>(count) == 0 && count == 0x1234);
+  fifoDevice.setRetry(1);
+  CHECK(fifoDevice.streamFromRegister(0x74, ring, 5) == 5 && fifo.getCount() == 0);
+}
+
+static void testPortDevice() {
+  uint8_t data[2] = {0x0F, 0xF0};
+  uint8_t value = 0;
+
+  pcf.setPort(0xA5);
+  CHECK(pcfDevice.readFromDevice(value) == 1);
+  report("readFromDevice(1)");
+  CHECK(value == 0xA5);
+  CHECK(pcfDevice.writeToDevice(0x3C) == 1);
+  report("writeToDevice(1)");
+  CHECK(pcf.getPort() == 0x3C);
+  CHECK(pcfDevice.writeToDevice(data, 2) == 1);
+  CHECK(pcf.getPort() == 0xF0);
+  CHECK(pcfDevice.write1bToDevice(0x11) == 1 && pcf.getPort() == 0x11);
+  CHECK(pcfDevice.writeBytesToDevice(data, 2) == 1 && pcf.getPort() == 0xF0);
+  CHECK(pcfDevice.read1bFromDevice(&value) == 1 && value == 0xF0);
+  CHECK(pcfDevice.readBytesFromDevice(data, 2) == 1 && data[0] == 0xF0);
+}
+
+static void testClockStretch() {
+  uint8_t value = 0;
+
+  slow.setClockStretch(20);
+  slowRegisters[3] = 0x77;
+  CHECK(slowDevice.readFromRegister(3, value) == 1);
+  report("readFromRegister, stretched");
+  CHECK(value == 0x77);
+  CHECK(simBus.getTransactionCounters().stretchReads > 0);
+  CHECK(slowDevice.checkStretchTimeout() == 0);
+
+  // Held longer than the timeout on every clock, so recover() cannot end
+  // the transaction either
+  slowDevice.setStretchTimeout(1);
+  slow.setClockStretch(1500);
+  CHECK(slowDevice.readFromRegister(3, value) == 0);
+  CHECK(slowDevice.getLastError() == SWI2C_MSG_BUS_STUCK);
+  slow.setClockStretch(0);
+  slowDevice.setStretchTimeout(500);
+  CHECK(slowDevice.readFromRegister(3, value) == 1 && value == 0x77);
+}
+
+static void testNack() {
+  uint8_t value = 0;
+
+  nacker.setNackAddress(true);
+  CHECK(nackDevice.writeToRegister(1, 2) == 0);
+  report("writeToRegister, NACK");
+  CHECK(nackDevice.getLastError() == SWI2C_MSG_ADDRESS_NACK);
+  CHECK(nackDevice.readFromRegister(1, value) == 0);
+  CHECK(absentDevice.readFromDevice(value) == 0);
+  CHECK(absentDevice.getLastError() == SWI2C_MSG_ADDRESS_NACK);
+  nacker.setNackAddress(false);
+  nacker.setNackAfter(1);
+  uint8_t data[3] = {1, 2, 3};
+  CHECK(nackDevice.writeToRegister(1, data, 3) == 0);
+  CHECK(nackDevice.getLastError() == SWI2C_MSG_DATA_NACK);
+  nacker.setNackAfter(0);
+}
+
+static void testLowLevelMethods() {
+  uint8_t value;
+
+  registers[0x40] = 0xC3;
+  registers[0x41] = 0x3C;
+  mpuDevice.startBit();
+  mpuDevice.writeAddress(0);
+  CHECK(mpuDevice.checkAckBit() == 0);
+  mpuDevice.writeRegister(0x40);
+  CHECK(mpuDevice.checkAckBit() == 0);
+  mpuDevice.startBit();
+  mpuDevice.writeAddress(1);
+  CHECK(mpuDevice.checkAckBit() == 0);
+  value = mpuDevice.read1Byte();
+  mpuDevice.writeAck();
+  CHECK(value == 0xC3);
+  value = mpuDevice.read1Byte();
+  mpuDevice.checkAckBit();
+  mpuDevice.stopBit();
+  report("low level read(2)");
+  CHECK(value == 0x3C);
+
+  mpuDevice.startBit();
+  mpuDevice.writeAddress(0);
+  CHECK(mpuDevice.checkAckBit() == 0);
+  mpuDevice.writeByte(0x42);
+  CHECK(mpuDevice.checkAckBit() == 0);
+  mpuDevice.writeByte(0x99);
+  CHECK(mpuDevice.checkAckBit() == 0);
+  mpuDevice.stopBit();
+  CHECK(registers[0x42] == 0x99);
+  CHECK(mpuDevice.recover() == SWI2C_MSG_OK);
+}
+
+static void testTransferAndScan() {
+  uint8_t reg = 0x10;
+  uint8_t readBack[6];
+  uint8_t status[2];
+  SWI2C_Msg msgs[2] = {
+    {0x68, 0, 1, &reg},
+    {0x68, SWI2C_M_RD, 6, readBack}
+  };
+  SWI2C_ScanMap map;
+
+  CHECK(mpuDevice.transfer(msgs, 2, status) == 2);
+  report("transfer(write 1, read 6)");
+  CHECK(status[0] == SWI2C_MSG_OK && status[1] == SWI2C_MSG_OK);
+  CHECK(memcmp(readBack, registers + 0x10, 6) == 0);
+  CHECK(mpuDevice.scan(map) == 6);   // mpu, pcf, slow, nacker, fifo, eeprom
+  CHECK(map.isPresent(0x68) && map.isPresent(0x38) && !map.isPresent(0x20));
+  CHECK(mpuDevice.rescan(map) == 0);
+}
+
+static void testTransferTimeout() {
+  // Each transfer() reports its own stretch timeout, even if the timeout
+  // flag from an earlier one was never checked with checkStretchTimeout()
+  uint8_t data = 0;
+  SWI2C_Msg msg = {0x48, SWI2C_M_RD, 1, &data};
+  uint8_t status = SWI2C_MSG_OK;
+
+  slowDevice.setStretchTimeout(1);
+  slow.setClockStretch(1500);
+  CHECK(slowDevice.transfer(&msg, 1, &status) == 0);
+  CHECK(status == SWI2C_MSG_STRETCH_TIMEOUT);
+
+  // Let the device finish, then time out again with the flag still set
+  slow.setClockStretch(0);
+  CHECK(slowDevice.recover() == SWI2C_MSG_OK);
+  slow.setClockStretch(1500);
+  CHECK(slowDevice.transfer(&msg, 1, &status) == 0);
+  CHECK(status == SWI2C_MSG_STRETCH_TIMEOUT);
+  CHECK(slowDevice.getLastError() == SWI2C_MSG_STRETCH_TIMEOUT);
+  slow.setClockStretch(0);
+  slowDevice.setStretchTimeout(500);
+  CHECK(slowDevice.checkStretchTimeout() != 0);
+  CHECK(slowDevice.transfer(&msg, 1, &status) == 1 && status == SWI2C_MSG_OK);
+}
+
+static void testSMBusTimeout() {
+  // An SMBus transaction reports only its own stretch timeout, and leaves
+  // the flag read by checkStretchTimeout() for the caller
+  SWI2CSMBus<SWI2CSim> smbus(slowDevice);
+  uint8_t value = 0;
+
+  // Held longer than the timeout on every clock, as in testClockStretch()
+  slowDevice.setStretchTimeout(1);
+  slow.setClockStretch(1500);
+  CHECK(smbus.readByteData(3, value) == 0);
+  CHECK(smbus.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(slowDevice.readFromRegister(3, value) == 0);   // Sets the flag again
+  slow.setClockStretch(0);
+  slowDevice.setStretchTimeout(500);
+  CHECK(smbus.readByteData(3, value) == 1 && value == 0x77);
+  CHECK(smbus.getLastError() == SWI2C_MSG_OK);
+  CHECK(slowDevice.checkStretchTimeout() != 0);
+  CHECK(slowDevice.checkStretchTimeout() == 0);
+}
+
+static void testEEPROMTimeout() {
+  // The same for an EEPROM operation
+  SWI2CEEPROM<SWI2CSim> eeprom(slowDevice, 16, 1);
+  uint8_t value = 0;
+
+  slowDevice.setStretchTimeout(1);
+  slow.setClockStretch(1500);
+  CHECK(eeprom.read(3, &value, 1) == 0);
+  CHECK(eeprom.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(slowDevice.readFromRegister(3, value) == 0);   // Sets the flag again
+  slow.setClockStretch(0);
+  slowDevice.setStretchTimeout(500);
+  CHECK(eeprom.read(3, &value, 1) == 1 && value == 0x77);
+  CHECK(eeprom.getLastError() == SWI2C_MSG_OK);
+  CHECK(slowDevice.checkStretchTimeout() != 0);
+  CHECK(slowDevice.checkStretchTimeout() == 0);
+}
+
+static void testSchedulerZeroPeriod() {
+  // A job with a period of 0 is not added
+  uint8_t accel[6];
+  SWI2CScheduler<SWI2CSim, 1> scheduler;
+
+  CHECK(scheduler.addJob(mpuDevice, 0x3B, accel, 6, 0) == SWI2C_SCHED_FULL);
+  CHECK(scheduler.run() == 0);
+  CHECK(scheduler.addJob(mpuDevice, 0x3B, accel, 6, 1000) == 0);
+  CHECK(scheduler.run() == 1);
+}
+
+static void testSchedulerMergeGap() {
+  // Jobs merge with at most getMergeGap() unneeded registers between them
+  uint8_t accel[6], gyro[6];
+  SWI2CScheduler<SWI2CSim, 2> gapOf2;
+  SWI2CScheduler<SWI2CSim, 2> gapOf3;
+  SWI2CScheduler<SWI2CSim, 2> adjacent;
+
+  for (uint8_t i = 0; i < 16; i++) registers[0x3B + i] = i;
+  gapOf2.addJob(mpuDevice, 0x3B, accel, 6, 1000);
+  gapOf2.addJob(mpuDevice, 0x43, gyro, 6, 1000);
+  CHECK(gapOf2.run() == 2 && gapOf2.getReads() == 1);
+  CHECK(accel[0] == 0 && gyro[0] == 8 && gyro[5] == 13);
+
+  gapOf3.addJob(mpuDevice, 0x3B, accel, 6, 1000);
+  gapOf3.addJob(mpuDevice, 0x44, gyro, 6, 1000);
+  CHECK(gapOf3.run() == 2 && gapOf3.getReads() == 2);
+  CHECK(gyro[0] == 9);
+
+  adjacent.setMergeGap(0);
+  adjacent.addJob(mpuDevice, 0x3B, accel, 6, 1000);
+  adjacent.addJob(mpuDevice, 0x41, gyro, 6, 1000);
+  CHECK(adjacent.run() == 2 && adjacent.getReads() == 1);
+  CHECK(gyro[0] == 6);
+}
+
+static void testStuckBus() {
+  // A device holding SDA low that 9 clocks do not free: each method fails
+  // with SWI2C_MSG_BUS_STUCK, without sending a START
+  uint8_t value = 0x55;
+  uint8_t buffer[4];
+  uint8_t status[1];
+  SWI2C_Msg msg = {0x68, SWI2C_M_RD, 1, &value};
+  SWI2C_ScanMap map;
+  uint8_t ringBuffer[8];
+  SWI2CRing ring(ringBuffer, sizeof(ringBuffer));
+  SWI2CEEPROM<SWI2CSim> eeprom(mpuDevice, 16, 1);
+  SWI2CSMBus<SWI2CSim> smbus(mpuDevice, true);
+  uint16_t word = 0;
+  unsigned long transactions;
+
+  simBus.targetDriveLow(SWI2C_SimBus::LINE_SDA);
+  transactions = simBus.getCounters().transactions;
+  CHECK(mpuDevice.readFromRegister(0x10, value) == 0);
+  CHECK(mpuDevice.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(value == 0x55);
+  CHECK(mpuDevice.writeToRegister(0x10, 0x01) == 0);
+  CHECK(mpuDevice.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(mpuDevice.transfer(&msg, 1, status) == 0);
+  CHECK(status[0] == SWI2C_MSG_BUS_STUCK);
+  CHECK(mpuDevice.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(mpuDevice.scan(map) == 0);
+  CHECK(mpuDevice.streamFromRegister(0x10, ring, 4) == 0);
+  CHECK(mpuDevice.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(eeprom.read(0, buffer, 4) == 0);
+  CHECK(eeprom.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(eeprom.write(0, buffer, 4) == 0);
+  CHECK(eeprom.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(smbus.readWordData(0x10, word) == 0);
+  CHECK(smbus.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(smbus.writeByteData(0x10, 0x01) == 0);
+  CHECK(smbus.getLastError() == SWI2C_MSG_BUS_STUCK);
+  CHECK(simBus.getCounters().transactions == transactions);
+
+  simBus.targetRelease(SWI2C_SimBus::LINE_SDA);
+  CHECK(mpuDevice.readFromRegister(0x10, value) == 1);
+  CHECK(mpuDevice.getLastError() == SWI2C_MSG_OK);
+  smbus.setPEC(false);
+  CHECK(smbus.writeByteData(0x10, 0x01) == 1 && registers[0x10] == 0x01);
+  CHECK(smbus.getLastError() == SWI2C_MSG_OK);
+}
+
+static void testRetryClearsError() {
+  // An address NACK followed by a successful retry leaves no error behind
+  uint8_t ringBuffer[8];
+  SWI2CRing ring(ringBuffer, sizeof(ringBuffer));
+  uint8_t value = 0;
+  uint8_t first = fifo.getNextValue();
+
+  fifoDevice.setRetry(2);
+  fifo.fill(4);
+  fifo.nacks = 1;
+  CHECK(fifoDevice.streamFromRegister(0x74, ring, 4) == 4);
+  CHECK(fifoDevice.getLastError() == SWI2C_MSG_OK);
+  CHECK(fifoDevice.getAttempts() == 2);
+  CHECK(ring.available() == 4);
+  CHECK(ring.read() == first && ring.read() == first + 1 && ring.read() == first + 2 && ring.read() == first + 3);
+  CHECK(fifo.getCount() == 0);
+
+  // The bus was left free, with the transaction ended
+  CHECK(fifoDevice.tryAcquire());
+  fifoDevice.release();
+  CHECK(simBus.level(SWI2C_SimBus::LINE_SDA) == HIGH && simBus.level(SWI2C_SimBus::LINE_SCL) == HIGH);
+  CHECK(mpuDevice.readFromRegister(0x10, value) == 1);
+
+  fifo.nacks = 1;
+  CHECK(fifoDevice.readFromRegister(0x72, &value, 1) == 1);
+  CHECK(fifoDevice.getLastError() == SWI2C_MSG_OK);
+  fifo.nacks = 2;
+  CHECK(fifoDevice.readFromRegister(0x72, &value, 1) == 0);
+  CHECK(fifoDevice.getLastError() == SWI2C_MSG_ADDRESS_NACK);
+  fifoDevice.setRetry(1);
+}
+
+static void testOpenTransaction() {
+  // transfer() and scan() continue a transaction left open by a high
+  // level method, instead of waiting for the bus forever
+  uint8_t value = 0;
+  uint8_t readBack[2];
+  SWI2C_Msg msg = {0x68, SWI2C_M_RD, 2, readBack};
+  SWI2C_ScanMap map;
+  SWI2CSMBus<SWI2CSim> smbus(mpuDevice);
+  SWI2CEEPROM<SWI2CSim> eeprom(mpuDevice, 16, 1);
+
+  registers[0x30] = 0x12;
+  registers[0x31] = 0x34;
+  CHECK(mpuDevice.readFromRegister(0x30, value, false) == 1);
+  CHECK(value == 0x12);
+  CHECK(!mpuDevice.tryAcquire());   // Still owned by the open transaction
+  CHECK(mpuDevice.transfer(&msg, 1) == 1);
+  CHECK(readBack[0] == 0x34);   // Register pointer continued from the open read
+  CHECK(mpuDevice.tryAcquire());
+  mpuDevice.release();
+
+  CHECK(mpuDevice.readFromRegister(0x30, value, false) == 1);
+  CHECK(mpuDevice.scan(map) == 6);
+  CHECK(mpuDevice.tryAcquire());
+  mpuDevice.release();
+  CHECK(simBus.level(SWI2C_SimBus::LINE_SDA) == HIGH && simBus.level(SWI2C_SimBus::LINE_SCL) == HIGH);
+
+  // Nothing to probe: the open transaction still ends with a STOP
+  CHECK(mpuDevice.readFromRegister(0x30, value, false) == 1);
+  CHECK(mpuDevice.rescan(map, 0) == 0);
+  CHECK(mpuDevice.tryAcquire());
+  mpuDevice.release();
+  CHECK(simBus.level(SWI2C_SimBus::LINE_SDA) == HIGH && simBus.level(SWI2C_SimBus::LINE_SCL) == HIGH);
+
+  // The SMBus and EEPROM layers continue it in the same way
+  CHECK(mpuDevice.readFromRegister(0x30, value, false) == 1);
+  CHECK(smbus.readByteData(0x31, value) == 1 && value == 0x34);
+  CHECK(mpuDevice.tryAcquire());
+  mpuDevice.release();
+
+  CHECK(mpuDevice.readFromRegister(0x30, value, false) == 1);
+  CHECK(eeprom.read(0x31, readBack, 1) == 1 && readBack[0] == 0x34);
+  CHECK(mpuDevice.tryAcquire());
+  mpuDevice.release();
+
+  readBack[0] = 0x56;
+  readBack[1] = 0x78;
+  CHECK(mpuDevice.readFromRegister(0x30, value, false) == 1);
+  CHECK(eeprom.write(0x30, readBack, 2) == 1);
+  CHECK(registers[0x30] == 0x56 && registers[0x31] == 0x78);
+  CHECK(mpuDevice.tryAcquire());
+  mpuDevice.release();
+  CHECK(simBus.level(SWI2C_SimBus::LINE_SDA) == HIGH && simBus.level(SWI2C_SimBus::LINE_SCL) == HIGH);
+}
+
+// Shared bus for the tests of requests from interrupt handlers
+static SWI2CBusSim sharedBus(simBus);
+static SWI2CDeviceSim sharedMpu(sharedBus, 0x68);
+static SWI2C_Request requestEntries[4];
+static SWI2C_RequestQueue requestQueue(requestEntries, 4);
+static uint8_t requestBuffer[2];
+static int requestResult;
+static unsigned long requestRuns;
+static unsigned long requestWriteCycles;
+static uint8_t eepromMemory[256];
+static SWI2C_SimEEPROMDevice eepromModel(0x57, eepromMemory, sizeof(eepromMemory), 16, 1, 2000);
+
+static void onRequestDone(void*, int result) {
+  requestResult = result;
+  requestRuns++;
+  requestWriteCycles = eepromModel.getWriteCycles();
+}
+
+static void onDataReady() {
+  sharedMpu.requestFromRegister(0x10, requestBuffer, 2, onRequestDone);
+}
+
+static void testEEPROMFreesBusBetweenPages() {
+  // A request made during the first page of a 4 page write runs after that
+  // page's STOP, not after the last write cycle
+  SWI2CDeviceSim eepromDevice(sharedBus, 0x57);
+  SWI2CEEPROM<SWI2CDeviceSim> eeprom(eepromDevice, 16, 1);
+  uint8_t data[64];
+
+  for (uint8_t i = 0; i < sizeof(data); i++) data[i] = i;
+  sharedBus.setRequestQueue(&requestQueue);
+  requestRuns = 0;
+  simBus.setInterrupt(onDataReady, 0, 50);
+  CHECK(eeprom.write(0, data, sizeof(data)) == 1);
+  simBus.setInterrupt(0, 0, 0);
+  CHECK(memcmp(eepromMemory, data, sizeof(data)) == 0);
+  CHECK(requestRuns == 1);
+  CHECK(requestResult == 1);
+  CHECK(requestBuffer[0] == registers[0x10] && requestBuffer[1] == registers[0x11]);
+  CHECK(requestWriteCycles == 1);
+  CHECK(eeprom.getPolls() > 0);
+  CHECK(requestQueue.getStats().queued == 1);
+  sharedBus.setRequestQueue(0);
+}
+
+static void testEEPROMPageSize() {
+  // A page size of 0 writes one byte per page
+  SWI2CSim eepromDevice(simBus, 0x57);
+  SWI2CEEPROM<SWI2CSim> eeprom(eepromDevice, 0, 1);
+  uint8_t data[3] = {0x31, 0x32, 0x33};
+  uint8_t readBack[3];
+  unsigned long writeCycles = eepromModel.getWriteCycles();
+
+  CHECK(eeprom.write(0x80, data, sizeof(data)) == 1);
+  CHECK(eepromModel.getWriteCycles() - writeCycles == 3);
+  CHECK(eeprom.read(0x80, readBack, sizeof(readBack)) == 1);
+  CHECK(memcmp(readBack, data, sizeof(data)) == 0);
+}
+
+static SWI2CDeviceSim* requestDevice;
+static uint8_t requestError;
+
+static void onRegisterDone(void*, int result) {
+  requestResult = result;
+  requestError = requestDevice->getLastError();
+  requestRuns++;
+}
+
+static void onRegisterReady() {
+  requestDevice->requestFromRegister(3, requestBuffer, 1, onRegisterDone);
+}
+
+static void testRequestTiming() {
+  // millis() does not advance in an AVR interrupt handler, so a request
+  // must not wait on the time source for a backoff or a stretch timeout
+  SWI2CDeviceSim sharedSlow(sharedBus, 0x48);
+  SWI2CDeviceSim sharedNacker(sharedBus, 0x50);
+  unsigned long timeReads;
+  unsigned long busTime;
+
+  sharedBus.setRetry(3, 10);
+  nacker.setNackAddress(true);
+  requestDevice = &sharedNacker;
+  requestRuns = 0;
+  timeReads = simBus.getCounters().timeReads;
+  busTime = simBus.getCounters().busTime;
+  simBus.setInterrupt(onRegisterReady, 0, 10);
+  simBus.idle(100);
+  CHECK(requestRuns == 1);
+  CHECK(requestResult == 0 && requestError == SWI2C_MSG_ADDRESS_NACK);
+  CHECK(simBus.getCounters().timeReads == timeReads);
+  CHECK(simBus.getCounters().busTime - busTime < 10000UL);   // No backoff
+  nacker.setNackAddress(false);
+  sharedBus.setRetry(1);
+
+  // A request to a device that holds SCL still times out, counted in SCL reads
+  sharedBus.setStretchTimeout(2);
+  slow.setClockStretch(20000);
+  requestDevice = &sharedSlow;
+  requestRuns = 0;
+  busTime = simBus.getCounters().busTime;
+  simBus.setInterrupt(onRegisterReady, 0, 10);
+  simBus.idle(100);
+  slow.setClockStretch(0);
+  CHECK(requestRuns == 1);
+  CHECK(requestResult == 0);
+  CHECK(requestError == SWI2C_MSG_STRETCH_TIMEOUT || requestError == SWI2C_MSG_BUS_STUCK);
+  CHECK(simBus.getCounters().timeReads == timeReads);
+  CHECK(simBus.getCounters().busTime - busTime < 1000000UL);
+  sharedBus.setStretchTimeout(500);
+
+  // Outside of requests, the stretch timeout is still in milliseconds
+  simBus.setInterrupt(0, 0, 0);
+  requestDevice = 0;
+  CHECK(sharedSlow.readFromRegister(3, requestBuffer, 1) == 1 && requestBuffer[0] == slowRegisters[3]);
+}
+
+int main() {
+  simBus.attach(mpu);
+  simBus.attach(pcf);
+  simBus.attach(slow);
+  simBus.attach(nacker);
+  simBus.attach(fifo);
+  simBus.attach(eepromModel);
+  mpuDevice.begin();
+
+  RUN(testRegisterDevice);
+  RUN(testLegacyMethods);
+  RUN(testRingSize);
+  RUN(testSamplerSize);
+  RUN(testTypedRegisters);
+  RUN(testPortDevice);
+  RUN(testClockStretch);
+  RUN(testNack);
+  RUN(testLowLevelMethods);
+  RUN(testTransferAndScan);
+  RUN(testTransferTimeout);
+  RUN(testSMBusTimeout);
+  RUN(testEEPROMTimeout);
+  RUN(testSchedulerMergeGap);
+  RUN(testSchedulerZeroPeriod);
+  RUN(testStuckBus);
+  RUN(testRetryClearsError);
+  RUN(testOpenTransaction);
+  RUN(testEEPROMFreesBusBetweenPages);
+  RUN(testEEPROMPageSize);
+  RUN(testRequestTiming);
+  return testResult();
+}
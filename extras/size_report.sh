@@ -0,0 +1,43 @@
+#!/bin/sh
+# -----------------------------------------------------------------
+#   SWI2C Library - Flash and RAM used by each SWI2C_Config.h configuration
+#   https://github.com/Andy4495/SWI2C
+#   MIT License
+#
+#   10/16/2026 - Andy4495 - Original
+#
+#   Compiles the SWI2C_SizeReport example with arduino-cli for each
+#   configuration and prints the flash and RAM it uses:
+#
+#     extras/size_report.sh [FQBN]      (default arduino:avr:uno)
+#
+#   The board's core must be installed (arduino-cli core install ...).
+# -----------------------------------------------------------------
+
+FQBN=${1:-arduino:avr:uno}
+LIBRARY=$(cd "$(dirname "$0")/.." && pwd)
+SKETCH="$LIBRARY/examples/SWI2C_SizeReport"
+
+report() {
+  # $1: configuration name, $2: compiler flags
+  output=$(arduino-cli compile --clean --fqbn "$FQBN" --library "$LIBRARY" \
+           --build-property "compiler.cpp.extra_flags=$2" "$SKETCH" 2>&1)
+  if [ $? -ne 0 ]; then
+    printf "%-24s compile failed\n" "$1"
+    echo "$output" | grep -m 5 "error"
+    return
+  fi
+  flash=$(echo "$output" | sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p')
+  ram=$(echo "$output" | sed -n 's/^Global variables use \([0-9]*\) bytes.*/\1/p')
+  printf "%-24s %8s %8s   %s\n" "$1" "$flash" "$ram" "$2"
+}
+
+echo "SWI2C size report for $FQBN"
+printf "%-24s %8s %8s   %s\n" "Configuration" "Flash" "RAM" "Flags"
+report "default"            ""
+report "no stretch timeout" "-DSWI2C_STRETCH_TIMEOUT=0"
+report "no retry"           "-DSWI2C_RETRY=0"
+report "no legacy API"      "-DSWI2C_LEGACY_API=0"
+report "no bus lock"        "-DSWI2C_BUS_LOCK=0"
+report "minimal"            "-DSWI2C_STRETCH_TIMEOUT=0 -DSWI2C_RETRY=0 -DSWI2C_LEGACY_API=0 -DSWI2C_BUS_LOCK=0"
+report "statistics"         "-DSWI2C_STATS=1"
@@ -9,70 +9,48 @@
    09/16/2021 - A.T. - Add support for Repeated Start (Issue #5)
    07/27/2022 - Andy4495 - Support single-register devices (Issue #3)
    08/19/2022 - Andy4495 - Consistently use unsigned, fix-sized types where appropriate
+   10/16/2026 - Andy4495 - Use SWI2C_PinLine driver for SDA and SCL
+   10/16/2026 - Andy4495 - SWI2C is now a wrapper over SWI2CCore (SWI2C_Core.h)
+                         - Add SWI2CT class template with compile-time pins
+   10/16/2026 - Andy4495 - Add SWI2CBus and SWI2CDevice for many devices on one bus
 */
 
 #ifndef SWI2C_H
 #define SWI2C_H
 
 #include "Arduino.h"
+#include "SWI2C_PinDriver.h"
+#include "SWI2C_Core.h"
 
-class SWI2C {
+// Pins are chosen at runtime. One copy of the protocol code is shared by
+// all SWI2C objects, regardless of pin numbers.
+class SWI2C : public SWI2CCore<SWI2C_PinLine, SWI2C_PinLine> {
 public:
   SWI2C(uint8_t sda_pin, uint8_t scl_pin, uint8_t deviceID);
-  void begin();
-
-  // Basic high level methods
-  int writeToRegister(uint8_t regAddress, uint8_t data, bool sendStopBit = true);
-  int writeToRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit = true);
-  int writeToDevice(uint8_t data, bool sendStopBit = true);
-  int writeToDevice(uint8_t* buffer, uint8_t count, bool sendStopBit = true);
-
-  int readFromRegister(uint8_t regAddress, uint8_t &data, bool sendStopBit = true);
-  int readFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit = true);
-  int readFromDevice(uint8_t &data, bool sendStopBit = true);
-  int readFromDevice(uint8_t* buffer, uint8_t count, bool sendStopBit = true);
-
-  // Other high level methods for more specific use cases
-  int write1bToRegister(uint8_t regAddress, uint8_t data, bool sendStopBit = true);
-  int write2bToRegister(uint8_t regAddress, uint16_t data, bool sendStopBit = true);
-  int write2bToRegisterMSBFirst(uint8_t regAddress, uint16_t data, bool sendStopBit = true) ;
-  int writeBytesToRegister(uint8_t regAddress, uint8_t* data, uint8_t count, bool sendStopBit = true);
-  int write1bToDevice(uint8_t data, bool sendStopBit = true);
-  int writeBytesToDevice(uint8_t* data, uint8_t count, bool sendStopBit = true);
-  int read1bFromRegister(uint8_t regAddress, uint8_t* data, bool sendStopBit = true);
-  int read2bFromRegister(uint8_t regAddress, uint16_t* data, bool sendStopBit = true);
-  int read2bFromRegisterMSBFirst(uint8_t regAddress, uint16_t* data, bool sendStopBit = true);
-  int readBytesFromRegister(uint8_t regAddress, uint8_t* data, uint8_t count, bool sendStopBit = true);
-  int read1bFromDevice(uint8_t* data, bool sendStopBit = true);
-  int readBytesFromDevice(uint8_t* data, uint8_t count, bool sendStopBit = true);
+};
 
-  // Low level methods
-  void sclHi();
-  void sclLo();
-  void sdaHi();
-  void sdaLo();
-  void startBit();
-  void writeAddress(uint8_t r_w);
-  uint8_t checkAckBit();
-  void writeAck();
-  void writeRegister(uint8_t regAddress);
-  void stopBit();
-  uint8_t read1Byte();
-  uint16_t read2Byte();
-  void writeByte(uint8_t data);
-  unsigned long getStretchTimeout();
-  void setStretchTimeout(unsigned long t);
-  int checkStretchTimeout();
-  uint8_t getDeviceID();
-  void setDeviceID(uint8_t deviceid);
+// Pins are fixed at compile time, e.g. SWI2CT<SDA_PIN, SCL_PIN> myDevice(DEVICE_ADDRESS);
+// Where the pin mapping is known to the compiler, each edge is a single instruction.
+// Each distinct pin pair gets its own copy of the protocol code.
+template <uint8_t SDA_PIN, uint8_t SCL_PIN>
+class SWI2CT : public SWI2CCore<SWI2C_FixedLine<SDA_PIN>, SWI2C_FixedLine<SCL_PIN> > {
+public:
+  SWI2CT(uint8_t deviceID) :
+    SWI2CCore<SWI2C_FixedLine<SDA_PIN>, SWI2C_FixedLine<SCL_PIN> >(SWI2C_FixedLine<SDA_PIN>(), SWI2C_FixedLine<SCL_PIN>(), deviceID) {}
+};
 
-private:
-  enum {DEFAULT_STRETCH_TIMEOUT = 500UL};   // ms timeout waiting for device to release SCL line
-  uint8_t _deviceID;
-  uint8_t _scl_pin;
-  uint8_t _sda_pin;
-  unsigned long _stretch_timeout_delay;
-  int _stretch_timeout_error;
+// Shared bus for many devices on the same pins. The bus owns the pins,
+// clock-stretching timeout, and bus state; each device is a small SWI2CDevice
+// handle holding only a reference to the bus and the device address:
+//   SWI2CBus bus(SDA_PIN, SCL_PIN);
+//   SWI2CDevice sensor(bus, 0x68);
+// SWI2CDevice has the same methods as SWI2C. Only one SWI2CBus object
+// should be created for a given pair of pins.
+class SWI2CBus : public SWI2CBusCore<SWI2C_PinLine, SWI2C_PinLine> {
+public:
+  SWI2CBus(uint8_t sda_pin, uint8_t scl_pin);
 };
 
+typedef SWI2CDeviceT<SWI2CBus> SWI2CDevice;
+
 #endif
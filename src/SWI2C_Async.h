@@ -0,0 +1,317 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Non-blocking transfers
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Own the bus for the whole transfer (SWI2C_BUS_LOCK)
+   10/16/2026 - Andy4495 - Apply the bus speed; set the bus's getLastError()
+*/
+/* -----------------------------------------------------------------
+   SWI2CAsyncT runs a batched transfer (see transfer() in SWI2C_Core.h)
+   a few SCL clocks at a time, so loop() is not blocked while a device
+   stretches the clock:
+
+     SWI2CBus bus(SDA_PIN, SCL_PIN);
+     SWI2CAsync async(bus);
+     ...
+     async.startTransfer(msgs, 2, status, onDone);
+     ...
+     void loop() {
+       async.poll();     // Returns right away while SCL is held low
+       // other work
+     }
+
+   Completion is reported with isBusy()/getResult() and, optionally, a
+   callback. poll() can also be called from a timer interrupt; the
+   callback then runs in the interrupt.
+
+   The transfer owns the bus (see SWI2C_Lock.h) from startTransfer()
+   until it is complete, so other methods wait for it, and requests from
+   interrupt handlers are queued until then. The bus's stretch timeout (setStretchTimeout()) applies to
+   each clock, and is measured across poll() calls.
+
+   The SCL low and high periods for the bus speed (setSpeed()) are the
+   same short delays as the blocking methods, so only clock stretching
+   makes poll() return early. When the transfer is complete, the bus's
+   getLastError() is set in the same way as transfer().
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_ASYNC_H
+#define SWI2C_ASYNC_H
+
+#include "Arduino.h"
+#include "SWI2C.h"
+
+// BUS is an SWI2CBusCore, for example SWI2CBus or SWI2CBusSim
+template <class BUS>
+class SWI2CAsyncT {
+public:
+  // <completed> is the number of messages completed, the same as the return value of transfer()
+  typedef void (*Callback)(int completed);
+
+  SWI2CAsyncT(BUS& bus);
+
+  // Starts a transfer in the background. Returns false, and does not start,
+  // if a transfer is already in progress, the bus is owned by other code, or
+  // a message is invalid (in which case <status> is filled in the same way as transfer()).
+  // <msgs>, <status>, and the message buffers must remain valid until the transfer is complete.
+  bool startTransfer(SWI2C_Msg* msgs, uint8_t count, uint8_t* status = 0, Callback callback = 0);
+
+  // Advances the transfer by up to <clocks> SCL clocks (9 clocks is one byte
+  // and its ACK). Returns early if a device is holding SCL low.
+  // Returns true while the transfer is still in progress.
+  bool poll(uint8_t clocks = 9);
+
+  bool isBusy() {return _state != IDLE;}
+  // True if the last poll() found SCL held low by a device
+  bool isStretching() {return _stretching;}
+  // Number of messages completed by the last transfer, valid once isBusy() is false
+  int getResult() {return _completed;}
+
+private:
+  enum State {IDLE, START, ADDRESS, ADDRESS_ACK, WRITE, WRITE_ACK, READ, READ_ACK, STOP};
+  void setupClock();
+  void clockHigh();
+  void beginData();
+  void messageDone();
+  void fail(uint8_t code);
+  void finish();
+
+  BUS* _bus;
+  SWI2C_Msg* _msgs;
+  uint8_t* _status;
+  Callback _callback;
+  uint8_t _count;
+  uint8_t _index;       // Current message
+  uint16_t _pos;        // Current byte in the message
+  uint8_t _state;
+  uint8_t _bit;
+  uint8_t _shift;
+  uint8_t _result;      // SWI2C_MSG_* code for the current message
+  bool _sclReleased;    // SCL released, waiting for it to go high
+  bool _stretching;
+  unsigned long _waitStart;
+  int _completed;
+};
+
+typedef SWI2CAsyncT<SWI2CBus> SWI2CAsync;
+
+template <class BUS>
+SWI2CAsyncT<BUS>::SWI2CAsyncT(BUS& bus) {
+  _bus = &bus;
+  _msgs = 0;
+  _status = 0;
+  _callback = 0;
+  _count = 0;
+  _index = 0;
+  _pos = 0;
+  _state = IDLE;
+  _bit = 0;
+  _shift = 0;
+  _result = SWI2C_MSG_OK;
+  _sclReleased = false;
+  _stretching = false;
+  _waitStart = 0;
+  _completed = 0;
+}
+
+template <class BUS>
+bool SWI2CAsyncT<BUS>::startTransfer(SWI2C_Msg* msgs, uint8_t count, uint8_t* status, Callback callback) {
+  uint8_t i;
+
+  if (_state != IDLE) return false;
+  i = BUS::checkMessages(msgs, count);
+  if (i < count) {
+    if (status) {
+      for (uint8_t j = 0; j < count; j++) status[j] = (j == i) ? SWI2C_MSG_INVALID : SWI2C_MSG_NOT_SENT;
+    }
+    _completed = 0;
+    return false;
+  }
+#if SWI2C_BUS_LOCK
+  if (!_bus->tryAcquire()) return false;
+#endif
+  _msgs = msgs;
+  _count = count;
+  _status = status;
+  _callback = callback;
+  _index = 0;
+  _result = SWI2C_MSG_OK;
+  _sclReleased = false;
+  _stretching = false;
+  _completed = 0;
+  _state = count ? START : STOP;
+  _bus->setLastError(SWI2C_MSG_OK);
+  return true;
+}
+
+template <class BUS>
+bool SWI2CAsyncT<BUS>::poll(uint8_t clocks) {
+  while (_state != IDLE) {
+    if (!_sclReleased) {
+      setupClock();   // Sets SDA for this clock and releases SCL
+      _sclReleased = true;
+    }
+    if (_bus->sclRead() == LOW) {
+      // Device is stretching the clock. Come back on the next poll().
+      unsigned long timeout = _bus->getStretchTimeout();
+      if (!_stretching) {
+        _stretching = true;
+        _waitStart = _bus->getMillis();
+      }
+      else if (timeout != 0 && _bus->getMillis() - _waitStart >= timeout) {
+        _stretching = false;
+        _sclReleased = false;
+        if (_state == STOP) finish();   // Give up on the STOP, as stopBit() does
+        else fail(SWI2C_MSG_STRETCH_TIMEOUT);
+      }
+      break;
+    }
+    _stretching = false;
+    _sclReleased = false;
+    _bus->highPeriod();   // SCL high period for the bus speed
+    clockHigh();    // Samples SDA if needed, then pulls SCL low for the next clock
+    if (clocks == 0 || --clocks == 0) break;
+  }
+  return _state != IDLE;
+}
+
+// First half of a clock: SDA is changed only while SCL is low
+template <class BUS>
+void SWI2CAsyncT<BUS>::setupClock() {
+  switch (_state) {
+    case START:       // Also a repeated START; SDA is released at this point
+      _bus->sdaHi();
+      break;
+    case ADDRESS:
+    case WRITE:
+      if (_shift & (0x80 >> _bit)) _bus->sdaHi();
+      else _bus->sdaLo();
+      break;
+    case READ_ACK:    // ACK unless this is the last byte read
+      if (_pos + 1 < _msgs[_index].len ||
+          (_index + 1 < _count && (_msgs[_index + 1].flags & SWI2C_M_NOSTART))) _bus->sdaLo();
+      else _bus->sdaHi();
+      break;
+    case STOP:
+      _bus->sdaLo();
+      break;
+    default:          // ADDRESS_ACK, WRITE_ACK, READ: release SDA for the device
+      _bus->sdaHi();
+      break;
+  }
+  _bus->lowPeriod();    // Complete the SCL low period for the bus speed
+  _bus->sclRelease();
+}
+
+// Second half of a clock: SCL is high
+template <class BUS>
+void SWI2CAsyncT<BUS>::clockHigh() {
+  switch (_state) {
+    case START:
+      _bus->sdaLo();
+      _bus->highPeriod();   // START hold time
+      _bus->sclLo();
+      _shift = (_msgs[_index].addr << 1) | ((_msgs[_index].flags & SWI2C_M_RD) ? 1 : 0);
+      _bit = 0;
+      _state = ADDRESS;
+      break;
+    case ADDRESS:
+    case WRITE:
+      _bus->sclLo();
+      if (++_bit == 8) _state = (_state == ADDRESS) ? ADDRESS_ACK : WRITE_ACK;
+      break;
+    case ADDRESS_ACK:
+    case WRITE_ACK:
+      if (_bus->sdaRead() == HIGH) {    // NACK
+        _bus->sclLo();
+        fail(_state == ADDRESS_ACK ? SWI2C_MSG_ADDRESS_NACK : SWI2C_MSG_DATA_NACK);
+        break;
+      }
+      _bus->sclLo();
+      if (_state == ADDRESS_ACK) beginData();
+      else if (++_pos < _msgs[_index].len) {
+        _shift = _msgs[_index].buf[_pos];
+        _bit = 0;
+        _state = WRITE;
+      }
+      else messageDone();
+      break;
+    case READ:
+      if (_bus->sdaRead() == HIGH) _shift |= (0x80 >> _bit);
+      _bus->sclLo();
+      if (++_bit == 8) {
+        _msgs[_index].buf[_pos] = _shift;
+        _state = READ_ACK;
+      }
+      break;
+    case READ_ACK:
+      _bus->sclLo();
+      _bus->sdaHi();  // Release the data line
+      if (++_pos < _msgs[_index].len) {
+        _shift = 0;
+        _bit = 0;
+        _state = READ;
+      }
+      else messageDone();
+      break;
+    case STOP:
+      _bus->sdaHi();
+      _bus->lowPeriod();    // Bus free time before the next START
+      finish();
+      break;
+    default:
+      break;
+  }
+}
+
+template <class BUS>
+void SWI2CAsyncT<BUS>::beginData() {
+  SWI2C_Msg& m = _msgs[_index];
+  _pos = 0;
+  _bit = 0;
+  if (m.len == 0) messageDone();
+  else if (m.flags & SWI2C_M_RD) {
+    _shift = 0;
+    _state = READ;
+  }
+  else {
+    _shift = m.buf[0];
+    _state = WRITE;
+  }
+}
+
+template <class BUS>
+void SWI2CAsyncT<BUS>::messageDone() {
+  if (_status) _status[_index] = SWI2C_MSG_OK;
+  if (++_index < _count) {
+    if (_msgs[_index].flags & SWI2C_M_NOSTART) beginData();
+    else _state = START;
+  }
+  else _state = STOP;
+}
+
+template <class BUS>
+void SWI2CAsyncT<BUS>::fail(uint8_t code) {
+  _result = code;
+  _bus->setLastError(code);
+  _state = STOP;
+}
+
+template <class BUS>
+void SWI2CAsyncT<BUS>::finish() {
+  _state = IDLE;
+  _completed = _index;
+  if (_status && _index < _count) {
+    _status[_index] = _result;
+    for (uint8_t j = _index + 1; j < _count; j++) _status[j] = SWI2C_MSG_NOT_SENT;
+  }
+#if SWI2C_BUS_LOCK
+  _bus->release();   // Before the callback, so that it can start another transfer
+#endif
+  if (_callback) _callback(_completed);
+}
+
+#endif
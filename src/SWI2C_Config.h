@@ -0,0 +1,58 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Compile-time feature selection
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   Features that can be left out of the build on parts with little
+   flash (for example, ATtiny). Like SWI2C_PIN_DRIVER and SWI2C_STATS,
+   each macro must be the same for the whole build, so set it in the
+   compiler flags (for example, -DSWI2C_RETRY=0), not in a sketch.
+
+   SWI2C_STRETCH_TIMEOUT (default 1):
+     0: SCL is waited for indefinitely when a device stretches the
+        clock, so sclHi() never reads the time source.
+        setStretchTimeout() has no effect, and checkStretchTimeout()
+        always returns 0.
+   SWI2C_RETRY (default 1):
+     0: each high level method makes a single attempt. setRetry() is
+        not available, and no backoff or budget code is compiled in.
+   SWI2C_LEGACY_API (default 1):
+     0: the older method names (write1bToRegister(), readBytesFromRegister(),
+        read2bFromRegisterMSBFirst(), ...) are not available. Use the
+        basic high level methods and typed registers (SWI2C_Register.h)
+        instead.
+   SWI2C_BUS_LOCK (default 1):
+     0: the bus has no lock (see SWI2C_Lock.h), and requests from
+        interrupt handlers are not available. Use when the bus is only
+        used from loop() (and code called from it).
+
+   Methods that a sketch does not call are not linked in any
+   configuration; these macros remove code from the methods that are
+   called. extras/size_report.sh prints the flash and RAM used by each
+   configuration.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_CONFIG_H
+#define SWI2C_CONFIG_H
+
+#ifndef SWI2C_STRETCH_TIMEOUT
+#define SWI2C_STRETCH_TIMEOUT 1
+#endif
+
+#ifndef SWI2C_RETRY
+#define SWI2C_RETRY 1
+#endif
+
+#ifndef SWI2C_LEGACY_API
+#define SWI2C_LEGACY_API 1
+#endif
+
+#ifndef SWI2C_BUS_LOCK
+#define SWI2C_BUS_LOCK 1
+#endif
+
+#endif
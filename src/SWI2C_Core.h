@@ -0,0 +1,1734 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Protocol core
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   03/25/2018 - A.T. - Original
+   07/04/2018 - A.T. - Add timeout for clock stretching
+   10/17/2018 - A.T. - Add 2-byte write method and methods to swap MSB/LSB
+                       for 2-byte reads and writes.
+   08/25/2021 - A.T. - Add error checking for NACKs received from device (Issue #4)
+   09/16/2021 - A.T. - Add support for Repeated Start (Issue #5)
+   06/15/2022 - A.T. - Properly handle NACK from device (Issue #6)
+   07/27/2022 - Andy4495 - Support single-register devices (Issue #3)
+   08/19/2022 - Andy4495 - Consistently use unsigned, fix-sized types where appropriate
+                         - Add simpler, basic high-level methods
+   01/10/2023 - Andy4495 - Fix #9 (send NACK after reading byte from device)
+   01/15/2023 - Andy4495 - Fix #10 (check ack after writing byte to device)
+   10/16/2026 - Andy4495 - Drive pins through SWI2C_PinLine; skip redundant SDA edges
+   10/16/2026 - Andy4495 - Move implementation from SWI2C.cpp into SWI2CCore class template
+                           so that pins can be fixed at compile time (SWI2CT)
+   10/16/2026 - Andy4495 - Split into SWI2CBusCore (pins, timing, bus state) and
+                           SWI2CDeviceAPI (device address and high level methods)
+   10/16/2026 - Andy4495 - Add transfer() for batched messages with repeated START
+   10/16/2026 - Andy4495 - Add non-blocking line access for SWI2CAsyncT
+   10/16/2026 - Andy4495 - Add bus speed profiles with calibrated delays
+   10/16/2026 - Andy4495 - Add streamFromRegister() and drainFIFO() for reads into a ring buffer
+   10/16/2026 - Andy4495 - Add scan() and rescan() address scanner
+   10/16/2026 - Andy4495 - Add bus recovery, retry policy, and getLastError() codes
+   10/16/2026 - Andy4495 - Add optional per-device statistics (SWI2C_STATS)
+   10/16/2026 - Andy4495 - Add typed register access (read<REG>, write<REG>, update<REG>);
+                           2-byte methods assemble bytes in order instead of swapping
+   10/16/2026 - Andy4495 - Add scatter-gather writes from RAM and PROGMEM segments
+   10/16/2026 - Andy4495 - Add SWI2C_MSG_PEC_ERROR
+   10/16/2026 - Andy4495 - High level methods share one transfer engine (transact());
+                           address and 2-byte reads reuse writeByte() and read1Byte();
+                           compile-time feature selection (SWI2C_Config.h)
+   10/16/2026 - Andy4495 - Add bus ownership and requests from interrupt handlers (SWI2C_BUS_LOCK)
+   10/16/2026 - Andy4495 - Add timestamped readFromRegister()
+   10/16/2026 - Andy4495 - Fail without using the bus if SDA is stuck low (SWI2C_MSG_BUS_STUCK)
+   10/16/2026 - Andy4495 - transfer(), scan(), and rescan() continue a transaction left open
+   10/16/2026 - Andy4495 - Requests do not use the time source for retry backoff or stretch timeout
+   10/16/2026 - Andy4495 - Typed and 2-byte reads assemble the value as it is received again
+   10/16/2026 - Andy4495 - transfer() reports a stretch timeout even if an earlier one was not checked
+   10/16/2026 - Andy4495 - Update the lock statistics atomically
+*/
+
+#ifndef SWI2C_CORE_H
+#define SWI2C_CORE_H
+
+#include "Arduino.h"
+#include "SWI2C_Config.h"
+#include "SWI2C_Lock.h"
+#include "SWI2C_PinDriver.h"
+#include "SWI2C_Ring.h"
+#include "SWI2C_Stats.h"
+#include "SWI2C_Register.h"
+
+// One segment of a batched transfer(). Same layout and flag values as the
+// Linux struct i2c_msg used with the I2C_RDWR ioctl, so message arrays can
+// be ported directly.
+struct SWI2C_Msg {
+  uint16_t addr;     // 7-bit device address
+  uint16_t flags;    // SWI2C_M_* flags, 0 for a write
+  uint16_t len;      // Number of bytes to write from or read into buf
+  uint8_t* buf;
+};
+
+#define SWI2C_M_RD       0x0001   // Read from the device (default is write)
+#define SWI2C_M_NOSTART  0x4000   // Continue the previous message without a repeated START
+                                  // or address. Must be the same direction as the previous message.
+
+// One piece of the data for a scatter-gather write. The segments of a write
+// are sent back to back in one transaction, directly from where they are
+// stored, so a command prefix and its payload do not need to be copied
+// into one buffer first.
+struct SWI2C_Segment {
+  const uint8_t* data;
+  uint16_t len;
+  uint8_t flags;     // SWI2C_SEG_* flags, 0 for data in RAM
+};
+
+#define SWI2C_SEG_PROGMEM  0x01   // <data> is in flash (PROGMEM)
+
+#ifdef pgm_read_byte
+#define SWI2C_READ_PROGMEM(p) pgm_read_byte(p)
+#else
+#define SWI2C_READ_PROGMEM(p) (*(p))   // Flash and RAM share one address space
+#endif
+
+// Per-message status returned by transfer()
+#define SWI2C_MSG_OK               1   // Message completed (same as the high level methods' return value)
+#define SWI2C_MSG_NOT_SENT         0   // Not sent, because an earlier message failed
+#define SWI2C_MSG_ADDRESS_NACK     2   // Device did not ACK its address
+#define SWI2C_MSG_DATA_NACK        3   // Device did not ACK a byte written to it
+#define SWI2C_MSG_STRETCH_TIMEOUT  4   // Clock-stretching timeout during the message
+#define SWI2C_MSG_INVALID          5   // Zero-length read, or SWI2C_M_NOSTART that cannot
+                                       // continue the previous message
+#define SWI2C_MSG_BUS_STUCK        6   // Device holding SDA low, or SCL still low after a timeout
+#define SWI2C_MSG_PEC_ERROR        7   // SMBus Packet Error Code did not match (SWI2CSMBus)
+
+// Presence map filled in by scan() and rescan(). One bit per 7-bit
+// address: bit (addr & 7) of byte (addr >> 3).
+struct SWI2C_ScanMap {
+  uint8_t present[16];     // Device ACKed its address
+  uint8_t stretched[16];   // Clock-stretching timeout during the last probe of the address
+  uint8_t changed[16];     // Presence changed at the last rescan()
+  uint8_t first;           // Address range scanned
+  uint8_t last;
+
+  bool isPresent(uint8_t addr) const {return present[(addr >> 3) & 0x0F] & (1 << (addr & 7));}
+  bool isStretched(uint8_t addr) const {return stretched[(addr >> 3) & 0x0F] & (1 << (addr & 7));}
+  bool isChanged(uint8_t addr) const {return changed[(addr >> 3) & 0x0F] & (1 << (addr & 7));}
+  uint8_t count() const {
+    uint8_t n = 0;
+    for (uint8_t addr = first; addr <= last && addr < 0x80; addr++) if (isPresent(addr)) n++;
+    return n;
+  }
+};
+
+// Addresses re-probed by rescan()
+#define SWI2C_RESCAN_PRESENT  1   // Addresses where a device was found (detects removal)
+#define SWI2C_RESCAN_ABSENT   2   // Addresses where no device was found (detects insertion)
+#define SWI2C_RESCAN_ALL      3
+
+#define SWI2C_SCAN_STRETCH_TIMEOUT  2UL   // Default ms to wait for SCL during each scan probe
+
+// Bus speed profiles for setSpeed(). Any other SCL frequency in Hz can also be used.
+#define SWI2C_SPEED_MAX          0UL        // No added delays: as fast as the pin driver allows
+#define SWI2C_SPEED_STANDARD     100000UL   // I2C standard mode
+#define SWI2C_SPEED_FAST         400000UL   // I2C fast mode
+
+// I2C bus: owns the SDA and SCL lines, the clock-stretching timeout, and the
+// bus state, and implements the low level protocol methods.
+// SDA_LINE and SCL_LINE are pin driver classes providing begin(), release(),
+// driveLow(), read(), and isReleased(), for example SWI2C_PinLine or
+// SWI2C_FixedLine. The SCL line class also provides getMillis() and
+// getMicros(), the time sources for the clock-stretching timeout and
+// speed calibration.
+//
+// <exclusive> is true if this object is the only one driving these pins
+// (e.g. SWI2CBus). It can then remember that the bus is idle after a STOP
+// and skip the SCL check at the next START.
+template <class SDA_LINE, class SCL_LINE>
+class SWI2CBusCore {
+public:
+  SWI2CBusCore(const SDA_LINE& sda, const SCL_LINE& scl, bool exclusive);
+  void begin();
+
+  // Low level methods
+  void sclHi();
+  void sclLo();
+  void sdaHi();
+  void sdaLo();
+  void startBit();
+  void writeAddress(uint8_t deviceID, uint8_t r_w);
+  uint8_t checkAckBit();
+  void writeAck();
+  void writeRegister(uint8_t regAddress);
+  void stopBit();
+  uint8_t read1Byte();
+  uint16_t read2Byte();
+  void writeByte(uint8_t data);
+  unsigned long getStretchTimeout();
+  void setStretchTimeout(unsigned long t);
+  int checkStretchTimeout();
+
+  // Batched transfer: all <count> messages are sent as one transaction,
+  // with a repeated START between messages and a single STOP at the end.
+  int transfer(SWI2C_Msg* msgs, uint8_t count, uint8_t* status = 0);
+  // Returns the index of the first message that cannot be sent, or <count> if all are valid
+  static uint8_t checkMessages(const SWI2C_Msg* msgs, uint8_t count);
+
+  // Address scan. Probes each address from <first> to <last> with its write
+  // address only, back to back with a repeated START between probes and one
+  // STOP at the end. <stretchTimeout> (ms) replaces the bus's clock-stretching
+  // timeout during the scan. A timeout is reported in map.stretched instead of
+  // checkStretchTimeout(), and the address is not marked present, since its
+  // ACK bit cannot be trusted. Returns the number of devices found.
+  uint8_t scan(SWI2C_ScanMap& map, uint8_t first = 0x08, uint8_t last = 0x77,
+               unsigned long stretchTimeout = SWI2C_SCAN_STRETCH_TIMEOUT);
+  // Re-probes only the addresses in the range of the last scan() that were
+  // present and/or absent (SWI2C_RESCAN_*), and updates <map>. Addresses that
+  // changed are set in map.changed. An address whose probe times out keeps its
+  // previous presence bit. Returns the number of changes.
+  uint8_t rescan(SWI2C_ScanMap& map, uint8_t which = SWI2C_RESCAN_ALL,
+                 unsigned long stretchTimeout = SWI2C_SCAN_STRETCH_TIMEOUT);
+
+  // Bus recovery: if a device is holding SDA low (for example, it was reset
+  // in the middle of a read), clocks SCL up to 9 times until SDA is released,
+  // then sends a STOP. Returns SWI2C_MSG_OK if both lines are released, or
+  // SWI2C_MSG_BUS_STUCK if not.
+  uint8_t recover();
+#if SWI2C_RETRY
+  // Retry policy for the high level methods. A failed transaction is tried
+  // up to <attempts> times in total. The first retry waits <backoff> ms, and
+  // each one after that waits twice as long as the one before. No retry is
+  // started if it would go past <budget> ms from the start of the first
+  // attempt (0 for no limit). Default is 1 attempt (no retries).
+  void setRetry(uint8_t attempts, unsigned long backoff = 0, unsigned long budget = 0);
+#endif
+  // SWI2C_MSG_* code for the last high level method or transfer(): SWI2C_MSG_OK,
+  // SWI2C_MSG_ADDRESS_NACK, SWI2C_MSG_DATA_NACK, SWI2C_MSG_STRETCH_TIMEOUT, or SWI2C_MSG_BUS_STUCK
+  uint8_t getLastError();
+  // Number of attempts made by the last high level method
+  uint8_t getAttempts();
+
+  // Used by the high level methods in SWI2CDeviceAPI to track attempts
+  bool beginAttempts();                      // False if SDA is stuck low and recover() failed
+  void attemptFailed(uint8_t code);           // Ends the transaction and records the error
+  bool finishAttempt(bool sendStopBit);      // False if SCL timed out during the attempt
+  bool retry();                              // True if another attempt should be made
+
+  // Target SCL frequency in Hz (SWI2C_SPEED_*). Takes effect at begin() or calibrate().
+  void setSpeed(unsigned long hz);
+  // Measures the pin driver speed and sets the delays needed to stay at or
+  // below the target frequency. Clocks SCL with SDA released. Returns the
+  // SCL frequency achieved, in Hz.
+  unsigned long calibrate();
+  // SCL frequency measured by the last calibrate(), 0 if not calibrated
+  unsigned long getSpeed();
+
+  // Non-blocking line access, used by SWI2CAsyncT. sclRelease() does not
+  // wait for a device that is stretching the clock. lowPeriod() and
+  // highPeriod() are the SCL low and high periods for the bus speed (the
+  // short delay loops set by calibrate()), and setLastError() records the
+  // result of a transfer for getLastError().
+  void sclRelease();
+  uint8_t sclRead();
+  uint8_t sdaRead();
+  void lowPeriod();
+  void highPeriod();
+  void setLastError(uint8_t code);
+  unsigned long getMillis();
+  unsigned long getMicros();
+#if SWI2C_STATS
+  // Statistics to receive clock stretch events, set by a device during a high level method
+  void setStatsTarget(SWI2C_Stats* stats) {_stats = stats;}
+#endif
+#if SWI2C_BUS_LOCK
+  // Bus ownership (see SWI2C_Lock.h). The high level methods, transfer(),
+  // scan(), and rescan() own the bus for each transaction. Use acquire()
+  // and release() around a sequence of low level methods. Not for
+  // interrupt handlers, which use submit() (or a device's request methods).
+  void acquire();               // Waits until the bus is free
+  bool tryAcquire();            // True if the bus was free and is now owned
+  void release();               // Runs any queued requests, then frees the bus
+  bool isBusy() {return _lock;}
+  // Queue for requests made while the bus is busy. Also keeps the lock
+  // statistics. Without a queue, a request made while the bus is busy fails.
+  void setRequestQueue(SWI2C_RequestQueue* queue) {_queue = queue;}
+  // Runs <request> now if the bus is free. Otherwise queues it to run when
+  // the owner releases the bus. False if it could not be run or queued.
+  bool submit(SWI2C_Request& request);
+  // Used by the high level methods, transfer(), scan(), rescan(), and the
+  // SWI2CEEPROM and SWI2CSMBus layers. A transaction left open (no STOP)
+  // keeps the bus until the method or stopBit() that ends it.
+  void beginOwned();
+  void endOwned(bool open);
+  void closeOwned();
+#endif
+
+protected:
+  enum {DEFAULT_STRETCH_TIMEOUT = 500UL};   // ms timeout waiting for device to release SCL line
+  enum {CALIBRATION_CLOCKS = 64, CALIBRATION_LOOPS = 10000};
+  SDA_LINE _sda;
+  SCL_LINE _scl;
+  unsigned long _stretch_timeout_delay;
+  int _stretch_timeout_error;
+  bool _exclusive;
+  uint8_t _idle;      // Set by stopBit() when both lines are known to be released
+  unsigned long _speed;           // Target SCL frequency, 0 for no delays
+  unsigned long _achievedSpeed;
+  uint16_t _lowDelay;             // Delay loop counts for the SCL low and high periods
+  uint16_t _highDelay;
+  uint8_t _lastError;
+  uint8_t _attempt;               // Attempts made so far by the current high level method
+  bool _attemptTimeout;           // SCL timeout during the current attempt
+  bool _stuck;                    // recover() could not free the bus
+#if SWI2C_RETRY
+  uint8_t _retryAttempts;
+  unsigned long _retryBackoff;
+  unsigned long _retryBudget;
+  unsigned long _retryStart;
+#endif
+#if SWI2C_STATS
+  SWI2C_Stats* _stats;
+#endif
+#if SWI2C_BUS_LOCK
+  volatile bool _lock;
+  bool _open;                     // Owned by a high level transaction without a STOP
+  bool _inRequest;                // Running a request, possibly in an interrupt handler
+  SWI2C_RequestQueue* _queue;
+#if SWI2C_STRETCH_TIMEOUT
+  unsigned long _sclReadsPerMs;   // Measured by the first request, for its stretch timeouts
+#endif
+
+  void runRequest(SWI2C_Request& request);
+  unsigned long measureReads();
+#endif
+
+  void wait(uint16_t loops);
+  uint16_t delayLoops(unsigned long ns, unsigned long loopTime);
+  void waitForScl();
+  unsigned long measureClocks();
+  uint8_t probe(SWI2C_ScanMap& map, uint8_t which, unsigned long stretchTimeout);
+};
+
+// High level methods for one device (7-bit address) on a bus. DERIVED
+// provides getBus(), which returns the BUS (an SWI2CBusCore) to use.
+// The low level bus methods are also available here so that every device
+// class has the complete SWI2C interface.
+template <class DERIVED, class BUS>
+class SWI2CDeviceAPI {
+public:
+  // Basic high level methods
+  int writeToRegister(uint8_t regAddress, uint8_t data, bool sendStopBit = true);
+  int writeToRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit = true);
+  int writeToDevice(uint8_t data, bool sendStopBit = true);
+  int writeToDevice(uint8_t* buffer, uint8_t count, bool sendStopBit = true);
+  // Scatter-gather writes: <count> segments, each up to 65535 bytes
+  int writeToRegister(uint8_t regAddress, const SWI2C_Segment* segments, uint8_t count, bool sendStopBit = true);
+  int writeToDevice(const SWI2C_Segment* segments, uint8_t count, bool sendStopBit = true);
+
+  int readFromRegister(uint8_t regAddress, uint8_t &data, bool sendStopBit = true);
+  int readFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit = true);
+  int readFromDevice(uint8_t &data, bool sendStopBit = true);
+  int readFromDevice(uint8_t* buffer, uint8_t count, bool sendStopBit = true);
+  // Timestamped read: also sets <timestamp> to getMicros() at the repeated
+  // START that begins the read, and <duration> to the us from then until
+  // the STOP is sent (or until the last byte, without a STOP)
+  int readFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                       unsigned long& timestamp, unsigned long& duration, bool sendStopBit = true);
+
+#if SWI2C_LEGACY_API
+  // Other high level methods for more specific use cases
+  int write1bToRegister(uint8_t regAddress, uint8_t data, bool sendStopBit = true);
+  int write2bToRegister(uint8_t regAddress, uint16_t data, bool sendStopBit = true);
+  int write2bToRegisterMSBFirst(uint8_t regAddress, uint16_t data, bool sendStopBit = true) ;
+  int writeBytesToRegister(uint8_t regAddress, uint8_t* data, uint8_t count, bool sendStopBit = true);
+  int write1bToDevice(uint8_t data, bool sendStopBit = true);
+  int writeBytesToDevice(uint8_t* data, uint8_t count, bool sendStopBit = true);
+  int read1bFromRegister(uint8_t regAddress, uint8_t* data, bool sendStopBit = true);
+  int read2bFromRegister(uint8_t regAddress, uint16_t* data, bool sendStopBit = true);
+  int read2bFromRegisterMSBFirst(uint8_t regAddress, uint16_t* data, bool sendStopBit = true);
+  int readBytesFromRegister(uint8_t regAddress, uint8_t* data, uint8_t count, bool sendStopBit = true);
+  int read1bFromDevice(uint8_t* data, bool sendStopBit = true);
+  int readBytesFromDevice(uint8_t* data, uint8_t count, bool sendStopBit = true);
+#endif
+
+  // Typed register access with a register descriptor (see SWI2C_Register.h).
+  // Same return codes as the other high level methods.
+  template <class REG> int read(typename REG::type& value, bool sendStopBit = true);
+  template <class REG> int write(typename REG::type value, bool sendStopBit = true);
+  // Read-modify-write: changes only the bits in <mask> to the matching bits of <value>
+  template <class REG> int update(typename REG::type mask, typename REG::type value);
+
+  // Streaming reads into a ring buffer, for device FIFOs. Return the number of bytes read, 0 if a NACK was detected.
+  uint16_t streamFromRegister(uint8_t regAddress, SWI2CRing& ring, uint16_t count, bool sendStopBit = true);
+  uint16_t drainFIFO(uint8_t countRegAddress, uint8_t dataRegAddress, SWI2CRing& ring, bool countMSBFirst = true);
+
+#if SWI2C_BUS_LOCK
+  // Requests, for interrupt handlers (see SWI2C_Lock.h). The transaction runs
+  // now if the bus is free, or after the current transaction if not, and
+  // <callback> is called with the result. <buffer> must stay valid until
+  // then. Return false if the request could not be run or queued.
+  // An interrupt handler must not call the other high level methods.
+  bool requestFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                           SWI2C_RequestCallback callback, void* context = 0);
+  bool requestToRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                         SWI2C_RequestCallback callback, void* context = 0);
+#endif
+
+  // Low level methods, passed through to the bus
+  void begin() {bus().begin();}
+  void sclHi() {bus().sclHi();}
+  void sclLo() {bus().sclLo();}
+  void sdaHi() {bus().sdaHi();}
+  void sdaLo() {bus().sdaLo();}
+  void startBit() {bus().startBit();}
+  void writeAddress(uint8_t r_w) {bus().writeAddress(_deviceID, r_w);}
+  uint8_t checkAckBit() {return bus().checkAckBit();}
+  void writeAck() {bus().writeAck();}
+  void writeRegister(uint8_t regAddress) {bus().writeRegister(regAddress);}
+  void stopBit();
+  uint8_t read1Byte() {return bus().read1Byte();}
+  uint16_t read2Byte() {return bus().read2Byte();}
+  void writeByte(uint8_t data) {bus().writeByte(data);}
+  unsigned long getStretchTimeout() {return bus().getStretchTimeout();}
+  void setStretchTimeout(unsigned long t) {bus().setStretchTimeout(t);}
+  int checkStretchTimeout() {return bus().checkStretchTimeout();}
+  int transfer(SWI2C_Msg* msgs, uint8_t count, uint8_t* status = 0) {return bus().transfer(msgs, count, status);}
+  uint8_t scan(SWI2C_ScanMap& map, uint8_t first = 0x08, uint8_t last = 0x77,
+               unsigned long stretchTimeout = SWI2C_SCAN_STRETCH_TIMEOUT) {return bus().scan(map, first, last, stretchTimeout);}
+  uint8_t rescan(SWI2C_ScanMap& map, uint8_t which = SWI2C_RESCAN_ALL,
+                 unsigned long stretchTimeout = SWI2C_SCAN_STRETCH_TIMEOUT) {return bus().rescan(map, which, stretchTimeout);}
+  void setSpeed(unsigned long hz) {bus().setSpeed(hz);}
+  unsigned long calibrate() {return bus().calibrate();}
+  unsigned long getSpeed() {return bus().getSpeed();}
+  uint8_t recover() {return bus().recover();}
+#if SWI2C_RETRY
+  void setRetry(uint8_t attempts, unsigned long backoff = 0, unsigned long budget = 0) {bus().setRetry(attempts, backoff, budget);}
+#endif
+  uint8_t getLastError() {return bus().getLastError();}
+  uint8_t getAttempts() {return bus().getAttempts();}
+#if SWI2C_BUS_LOCK
+  void acquire() {bus().acquire();}
+  bool tryAcquire() {return bus().tryAcquire();}
+  void release() {bus().release();}
+  void setRequestQueue(SWI2C_RequestQueue* queue) {bus().setRequestQueue(queue);}
+#endif
+  uint8_t getDeviceID();
+  void setDeviceID(uint8_t deviceid);
+
+#if SWI2C_STATS
+  // Statistics for this device (see SWI2C_Stats.h)
+  const SWI2C_Stats& getStats() {return _stats;}
+  void snapshotStats(SWI2C_Stats& snapshot, bool reset = false);
+  void resetStats() {_stats.reset();}
+#endif
+
+protected:
+  SWI2CDeviceAPI(uint8_t deviceID);
+  BUS& bus() {return static_cast<DERIVED*>(this)->getBus();}
+  // Transfer engine for the high level methods. <flags> selects the phases:
+  // XFER_REGISTER sends <regAddress> after the write address, and XFER_READ
+  // reads <count> bytes into <buffer> (after a repeated START if there is a
+  // register). Otherwise the <segmentCount> segments are written.
+  // XFER_OWNED is set for a request, which runs while the bus is already owned.
+  // If <times> is not null, times[0] is set at the START of the read and
+  // times[1] at the end of the transaction.
+  enum {XFER_REGISTER = 0x01, XFER_READ = 0x02, XFER_OWNED = 0x04};
+  int transact(uint8_t flags, uint8_t regAddress, const SWI2C_Segment* segments, uint8_t segmentCount,
+               uint8_t* buffer, uint8_t count, bool sendStopBit, unsigned long* times = 0);
+  bool select(uint8_t flags, uint8_t regAddress, unsigned long* times = 0);
+  bool beginOp(uint8_t flags = 0);
+  int endOp(uint8_t op, int result, uint8_t flags = 0, bool sendStopBit = true);
+#if SWI2C_BUS_LOCK
+  static int runRequest(SWI2C_Request& request);
+  bool makeRequest(uint8_t flags, uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                   SWI2C_RequestCallback callback, void* context);
+#endif
+  bool nack(uint8_t phase);
+  bool writeData(const uint8_t* buffer, uint16_t count, bool progmem = false);
+  bool writeSegments(const SWI2C_Segment* segments, uint8_t count);
+  void readData(uint8_t* buffer, uint8_t count);
+  template <uint8_t BYTES, uint8_t ORDER>
+  int readValue(uint8_t regAddress, typename SWI2C_RegType<BYTES, false>::type& raw, bool sendStopBit);
+  template <uint8_t BYTES, uint8_t ORDER>
+  int writeValue(uint8_t regAddress, typename SWI2C_RegType<BYTES, false>::type raw, bool sendStopBit);
+  uint8_t _deviceID;
+#if SWI2C_STATS
+  SWI2C_Stats _stats;
+  unsigned long _opStart;
+#endif
+};
+
+// Device with its own bus. This is the original SWI2C model: one object per
+// device, each with its own copy of the pins, timeout, and error flag.
+// Used by SWI2C (pins chosen at runtime) and SWI2CT (pins fixed at compile time).
+template <class SDA_LINE, class SCL_LINE>
+class SWI2CCore : public SWI2CDeviceAPI<SWI2CCore<SDA_LINE, SCL_LINE>, SWI2CBusCore<SDA_LINE, SCL_LINE> > {
+public:
+  SWI2CCore(const SDA_LINE& sda, const SCL_LINE& scl, uint8_t deviceID) :
+    SWI2CDeviceAPI<SWI2CCore<SDA_LINE, SCL_LINE>, SWI2CBusCore<SDA_LINE, SCL_LINE> >(deviceID),
+    _bus(sda, scl, false) {}   // Other objects may share these pins, so not exclusive
+  SWI2CBusCore<SDA_LINE, SCL_LINE>& getBus() {return _bus;}
+
+protected:
+  SWI2CBusCore<SDA_LINE, SCL_LINE> _bus;
+};
+
+// Lightweight handle for a device on a shared bus (e.g. SWI2CBus). Only holds
+// a reference to the bus and the device address.
+template <class BUS>
+class SWI2CDeviceT : public SWI2CDeviceAPI<SWI2CDeviceT<BUS>, BUS> {
+public:
+  SWI2CDeviceT(BUS& bus, uint8_t deviceID) : SWI2CDeviceAPI<SWI2CDeviceT<BUS>, BUS>(deviceID), _bus(&bus) {}
+  BUS& getBus() {return *_bus;}
+
+protected:
+  BUS* _bus;
+};
+
+template <class SDA_LINE, class SCL_LINE>
+SWI2CBusCore<SDA_LINE, SCL_LINE>::SWI2CBusCore(const SDA_LINE& sda, const SCL_LINE& scl, bool exclusive) : _sda(sda), _scl(scl) {
+  _stretch_timeout_delay = DEFAULT_STRETCH_TIMEOUT;
+  _stretch_timeout_error = 0;
+  _exclusive = exclusive;
+  _idle = 0;
+  _speed = SWI2C_SPEED_MAX;
+  _achievedSpeed = 0;
+  _lowDelay = 0;
+  _highDelay = 0;
+  _lastError = SWI2C_MSG_OK;
+  _attempt = 0;
+  _attemptTimeout = false;
+  _stuck = false;
+#if SWI2C_RETRY
+  _retryAttempts = 1;
+  _retryBackoff = 0;
+  _retryBudget = 0;
+  _retryStart = 0;
+#endif
+#if SWI2C_STATS
+  _stats = 0;
+#endif
+#if SWI2C_BUS_LOCK
+  _lock = false;
+  _open = false;
+  _inRequest = false;
+  _queue = 0;
+#if SWI2C_STRETCH_TIMEOUT
+  _sclReadsPerMs = 0;
+#endif
+#endif
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::begin() {
+  // Resolve the pin driver for each line and leave both lines released (high)
+  _scl.begin();
+  _sda.begin();
+  _idle = 0;
+  if (_speed != SWI2C_SPEED_MAX) calibrate();
+}
+
+// Low level methods
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::sclHi() {
+  wait(_lowDelay);    // Complete the SCL low period for the bus speed
+
+  // I2C pull-up resistor pulls SCL high in INPUT (Hi-Z) mode
+  // Always released, even if already released: another SWI2C object on the
+  // same pins may have left SCL low after a transfer without a STOP bit.
+  _scl.release();
+
+  // Check to make sure SCL pin has actually gone high before returning
+  // Device may be pulling SCL low to delay transfer (clock stretching)
+  if (_scl.read() == LOW) waitForScl();  // Common case is HIGH: no clock stretching, so no need to start timer
+
+  wait(_highDelay);   // SCL high period for the bus speed
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::waitForScl() {
+  bool released = false;
+#if SWI2C_STATS
+  unsigned long stretchStart = _scl.getMicros();
+#endif
+
+#if SWI2C_STRETCH_TIMEOUT
+  if ( _stretch_timeout_delay == 0) { // If timeout delay == 0, then wait indefinitely for SCL to go high
+#endif
+    while (_scl.read() == LOW) ;  // Empty statement: keep looping until not LOW
+    released = true;
+#if SWI2C_STRETCH_TIMEOUT
+  }
+  else {
+    // If SCL is not pulled high within a timeout period, then return anyway
+    // to avoid locking up the processor.
+#if SWI2C_BUS_LOCK
+    if (_inRequest) {
+      // The time source may not advance in an interrupt handler (millis() on AVR),
+      // so count SCL reads instead, at the rate measured by the first request
+      unsigned long reads = _stretch_timeout_delay * _sclReadsPerMs;
+      while (reads--) {
+        if (_scl.read() == HIGH) {
+          released = true;
+          break;
+        }
+      }
+    }
+    else
+#endif
+    {
+      unsigned long startTimer = _scl.getMillis();
+      while (_scl.getMillis() - startTimer < _stretch_timeout_delay) {
+        if (_scl.read() == HIGH) {  // SCL high before timeout, return without error
+          released = true;
+          break;
+        }
+      }
+    }
+    if (!released) {
+      // SCL did not go high within the timeout, so set error and return anyway.
+      _stretch_timeout_error = 1;
+      _attemptTimeout = true;
+    }
+  }
+#endif
+#if SWI2C_STATS
+  if (_stats) {
+    unsigned long stretch = _scl.getMicros() - stretchStart;
+    _stats->stretches++;
+    if (!released) _stats->stretchTimeouts++;
+    if (stretch > _stats->longestStretch) _stats->longestStretch = stretch;
+  }
+#else
+  (void)released;
+#endif
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::sclLo() {
+  _scl.driveLow();
+  _idle = 0;
+}
+
+// SDA is always released at the end of a transfer, so the tracked state can be
+// used to skip redundant edges (e.g. sdaHi() in checkAckBit() after writeByte())
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::sdaHi() {
+  if (!_sda.isReleased()) _sda.release();  // I2C pull-up resistor pulls signal high
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::sdaLo() {
+  if (_sda.isReleased()) _sda.driveLow();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::startBit() {  // Assume SDA already HIGH
+  // After our own STOP, SCL is already known to be high, so skip releasing and checking it
+  if (!_idle) sclHi();
+  sdaLo();
+  wait(_highDelay);   // START hold time
+  sclLo();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::writeAddress(uint8_t deviceID, uint8_t r_w) {  // Assume SCL, SDA already LOW from startBit()
+  // 7-bit address then the R/W bit, sent like a data byte. Leaves SDA released for the ACK.
+  writeByte((deviceID << 1) | (r_w & 0x01));
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::checkAckBit() { // Can also be used by controller to send NACK after last byte is read from device
+  uint8_t ack;
+  sdaHi();    // Release data line. This will cause a NACK from controller when reading bytes.
+  sclHi();
+  ack = _sda.read();
+  sclLo();
+  return ack;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::writeAck() {  // Used by controller to ACK to device bewteen multi-byte reads
+  sdaLo();
+  sclHi();
+  sclLo();
+  sdaHi();  // Release the data line
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::writeRegister(uint8_t reg_id) {
+  writeByte(reg_id);
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::stopBit() {  // Assume SCK is already LOW (from ack or data write)
+  sdaLo();
+  sclHi();
+  sdaHi();
+  wait(_lowDelay);    // Bus free time before the next START
+  // Bus is idle with both lines released, unless another object may use these pins
+  // or SCL did not go high (in which case the next startBit() needs to check again)
+  _idle = _exclusive && !_stretch_timeout_error;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::read1Byte() {
+  // Most significant bit first
+  uint8_t value = 0;
+  for (uint8_t mask = 0x80; mask; mask >>= 1) {
+    sclHi();
+    if (_sda.read() == 1) value |= mask;
+    sclLo();
+  }
+  return value;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint16_t SWI2CBusCore<SDA_LINE, SCL_LINE>::read2Byte() {
+  // Assumes LEAST significant BYTE is transferred first
+  uint16_t value = read1Byte();
+  writeAck();
+  return value | ((uint16_t)read1Byte() << 8);
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::writeByte(uint8_t data) {
+  // Most significant bit first
+  for (uint8_t mask = 0x80; mask; mask >>= 1) {
+    if (data & mask) sdaHi();
+    else sdaLo();
+    sclHi();
+    sclLo();
+  }
+  sdaHi();  // Release the data line for ACK from device
+}
+
+template <class SDA_LINE, class SCL_LINE>
+int SWI2CBusCore<SDA_LINE, SCL_LINE>::transfer(SWI2C_Msg* msgs, uint8_t count, uint8_t* status) {
+  // Returns the number of messages completed, which is <count> if there were no errors.
+  // If <status> is not null, it is filled with a SWI2C_MSG_* code for each message.
+  // The transaction ends at the first error: that message gets the error code,
+  // and later messages are SWI2C_MSG_NOT_SENT.
+  uint8_t i;
+  uint16_t j;
+  uint8_t result = SWI2C_MSG_OK;
+
+  // Check the whole batch before touching the bus
+  i = checkMessages(msgs, count);
+  if (i < count) {
+    if (status) {
+      for (j = 0; j < count; j++) status[j] = (j == i) ? SWI2C_MSG_INVALID : SWI2C_MSG_NOT_SENT;
+    }
+    return 0;
+  }
+
+#if SWI2C_BUS_LOCK
+  beginOwned();   // Continues a transaction left open by a high level method
+#endif
+  if (!beginAttempts()) result = SWI2C_MSG_BUS_STUCK;   // Nothing is sent on a stuck bus
+  for (i = 0; i < count && !_stuck; i++) {
+    SWI2C_Msg& m = msgs[i];
+    if (m.flags & SWI2C_M_RD) {
+      if (!(m.flags & SWI2C_M_NOSTART)) {
+        startBit();   // Repeated START after the first message
+        writeAddress(m.addr, 1);
+        if (checkAckBit()) {result = SWI2C_MSG_ADDRESS_NACK; break;}
+      }
+      // A read continued by the next message is ACKed on its last byte
+      bool continued = (i + 1 < count) && (msgs[i+1].flags & SWI2C_M_NOSTART);
+      for (j = 0; j < m.len; j++) {
+        m.buf[j] = read1Byte();
+        if (j + 1 < m.len || continued) writeAck();
+        else checkAckBit();   // NACK after the last byte
+      }
+    }
+    else {
+      if (!(m.flags & SWI2C_M_NOSTART)) {
+        startBit();
+        writeAddress(m.addr, 0);
+        if (checkAckBit()) {result = SWI2C_MSG_ADDRESS_NACK; break;}
+      }
+      for (j = 0; j < m.len; j++) {
+        writeByte(m.buf[j]);
+        if (checkAckBit()) {result = SWI2C_MSG_DATA_NACK; break;}
+      }
+      if (result != SWI2C_MSG_OK) break;
+    }
+    if (_attemptTimeout) {result = SWI2C_MSG_STRETCH_TIMEOUT; break;}   // SCL timed out during this transfer
+    if (status) status[i] = SWI2C_MSG_OK;
+  }
+  if (!_stuck) stopBit();
+  _lastError = (i < count) ? result : SWI2C_MSG_OK;
+
+  if (status && i < count) {
+    status[i] = result;
+    for (j = i + 1; j < count; j++) status[j] = SWI2C_MSG_NOT_SENT;
+  }
+#if SWI2C_BUS_LOCK
+  endOwned(false);
+#endif
+  return i;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::checkMessages(const SWI2C_Msg* msgs, uint8_t count) {
+  uint8_t i;
+  for (i = 0; i < count; i++) {
+    bool read = msgs[i].flags & SWI2C_M_RD;
+    if (msgs[i].flags & SWI2C_M_NOSTART) {
+      if (i == 0 || read != (bool)(msgs[i-1].flags & SWI2C_M_RD)) break;
+    }
+    else if (read && msgs[i].len == 0) break;  // Device would already be driving SDA
+  }
+  return i;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::scan(SWI2C_ScanMap& map, uint8_t first, uint8_t last, unsigned long stretchTimeout) {
+  memset(&map, 0, sizeof(map));
+  map.first = first;
+  map.last = (last > 0x7F) ? 0x7F : last;
+  probe(map, SWI2C_RESCAN_ALL, stretchTimeout);
+  memset(map.changed, 0, sizeof(map.changed));
+  return map.count();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::rescan(SWI2C_ScanMap& map, uint8_t which, unsigned long stretchTimeout) {
+  return probe(map, which, stretchTimeout);
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::probe(SWI2C_ScanMap& map, uint8_t which, unsigned long stretchTimeout) {
+  // Probes the selected addresses in map's range. Returns the number of addresses that changed.
+  unsigned long savedTimeout = _stretch_timeout_delay;
+  int savedError = _stretch_timeout_error;
+  bool inTransaction = false;
+  uint8_t changes = 0;
+  uint8_t i, bit;
+  bool found;
+
+  memset(map.changed, 0, sizeof(map.changed));
+#if SWI2C_BUS_LOCK
+  inTransaction = _open;   // A transaction left open by a high level method ends with the last STOP
+  beginOwned();
+#endif
+  if (!beginAttempts()) {
+    // With SDA held low, every address would appear to ACK
+#if SWI2C_BUS_LOCK
+    endOwned(false);
+#endif
+    return 0;
+  }
+  _stretch_timeout_delay = stretchTimeout;
+  _stretch_timeout_error = 0;
+  for (uint8_t addr = map.first; addr <= map.last && addr < 0x80; addr++) {
+    i = addr >> 3;
+    bit = 1 << (addr & 7);
+    if (!(which & ((map.present[i] & bit) ? SWI2C_RESCAN_PRESENT : SWI2C_RESCAN_ABSENT))) continue;
+    // A repeated START is legal after an ACK or a NACK, so no STOP is needed between probes
+    startBit();
+    writeAddress(addr, 0);
+    found = (checkAckBit() == 0);
+    inTransaction = true;
+    if (_stretch_timeout_error) {
+      // The ACK bit is not reliable if SCL was held low, so the presence
+      // bit is left as it was. End the transaction and start over at the
+      // next address.
+      map.stretched[i] |= bit;
+      _stretch_timeout_error = 0;
+      stopBit();
+      _stretch_timeout_error = 0;
+      inTransaction = false;
+      continue;
+    }
+    map.stretched[i] &= ~bit;
+    if (found != (bool)(map.present[i] & bit)) {
+      map.present[i] ^= bit;
+      map.changed[i] |= bit;
+      changes++;
+    }
+  }
+  if (inTransaction) stopBit();
+  _stretch_timeout_delay = savedTimeout;
+  _stretch_timeout_error = savedError;
+#if SWI2C_BUS_LOCK
+  endOwned(false);
+#endif
+  return changes;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::recover() {
+  uint8_t i;
+
+  sdaHi();
+  _scl.release();
+  _idle = 0;
+  if (_scl.read() == LOW) {
+    waitForScl();   // A device may still be stretching the clock
+    if (_scl.read() == LOW) return SWI2C_MSG_BUS_STUCK;   // Nothing the controller can do
+  }
+  // A device part way through sending a byte releases SDA after at most 8 data bits and the ACK bit
+  for (i = 0; i < 9 && _sda.read() == LOW; i++) {
+    sclLo();
+    sclHi();
+  }
+  if (_sda.read() == LOW) return SWI2C_MSG_BUS_STUCK;
+  // STOP, so that every device sees the end of the transaction
+  sclLo();
+  stopBit();
+  _idle = 0;
+  return (_scl.read() == HIGH && _sda.read() == HIGH) ? SWI2C_MSG_OK : SWI2C_MSG_BUS_STUCK;
+}
+
+#if SWI2C_RETRY
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::setRetry(uint8_t attempts, unsigned long backoff, unsigned long budget) {
+  _retryAttempts = attempts ? attempts : 1;
+  _retryBackoff = backoff;
+  _retryBudget = budget;
+}
+#endif
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::getLastError() {
+  return _lastError;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::getAttempts() {
+  return _attempt;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+bool SWI2CBusCore<SDA_LINE, SCL_LINE>::beginAttempts() {
+  _lastError = SWI2C_MSG_OK;
+  _attempt = 1;
+  _attemptTimeout = false;
+  _stuck = false;
+#if SWI2C_RETRY
+  // The time source is only read when there is a time budget to keep
+  if (_retryAttempts > 1 && _retryBudget) _retryStart = _scl.getMillis();
+#endif
+  // A device left driving SDA low (for example, reset part way through a
+  // read) hides the START, and would make the transaction appear to succeed.
+  // Not needed after our own STOP on an exclusive bus.
+  if (!_idle && _sda.isReleased() && _sda.read() == LOW && recover() != SWI2C_MSG_OK) {
+    _lastError = SWI2C_MSG_BUS_STUCK;
+    _stuck = true;
+  }
+  return !_stuck;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::attemptFailed(uint8_t code) {
+  // SCL is low and SDA is released here. SDA should follow, unless a device
+  // is stuck driving it. Only checked after a failure, so a successful
+  // transaction has no extra pin reads.
+  sdaHi();
+  if (_sda.read() == LOW) {
+    _lastError = SWI2C_MSG_BUS_STUCK;
+    _stuck = (recover() != SWI2C_MSG_OK);
+  }
+  else if (_attemptTimeout) {
+    // SCL may still be held low: recover() waits for it before the STOP
+    _lastError = SWI2C_MSG_STRETCH_TIMEOUT;
+    if (recover() != SWI2C_MSG_OK) {
+      _lastError = SWI2C_MSG_BUS_STUCK;
+      _stuck = true;
+    }
+  }
+  else {
+    stopBit();
+    _lastError = code;
+  }
+}
+
+template <class SDA_LINE, class SCL_LINE>
+bool SWI2CBusCore<SDA_LINE, SCL_LINE>::finishAttempt(bool sendStopBit) {
+  if (_attemptTimeout) {   // Data read while SCL was held low cannot be trusted
+    attemptFailed(SWI2C_MSG_STRETCH_TIMEOUT);
+    return false;
+  }
+  if (sendStopBit) stopBit();
+  _lastError = SWI2C_MSG_OK;
+  return true;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+bool SWI2CBusCore<SDA_LINE, SCL_LINE>::retry() {
+#if SWI2C_RETRY
+  unsigned long backoff;
+  unsigned long startTimer;
+
+  if (_attempt >= _retryAttempts || _stuck) return false;
+  backoff = _retryBackoff;
+  for (uint8_t i = 1; i < _attempt && backoff < 0x10000000UL; i++) backoff <<= 1;
+#if SWI2C_BUS_LOCK
+  if (_inRequest) backoff = 0;   // The time source may not advance in an interrupt handler
+#endif
+  if (_retryBudget) {
+    if (_scl.getMillis() - _retryStart + backoff >= _retryBudget) return false;
+  }
+  if (backoff) {
+    startTimer = _scl.getMillis();
+    while (_scl.getMillis() - startTimer < backoff) ;  // Empty statement: wait for the backoff time
+  }
+  _attempt++;
+  _attemptTimeout = false;
+  _lastError = SWI2C_MSG_OK;   // Each attempt reports only its own error
+  return true;
+#else
+  return false;   // Single attempt
+#endif
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::sclRelease() {
+  _scl.release();
+  _idle = 0;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::sclRead() {
+  return _scl.read();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint8_t SWI2CBusCore<SDA_LINE, SCL_LINE>::sdaRead() {
+  return _sda.read();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::lowPeriod() {
+  wait(_lowDelay);
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::highPeriod() {
+  wait(_highDelay);
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::setLastError(uint8_t code) {
+  _lastError = code;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+unsigned long SWI2CBusCore<SDA_LINE, SCL_LINE>::getMillis() {
+  return _scl.getMillis();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+unsigned long SWI2CBusCore<SDA_LINE, SCL_LINE>::getMicros() {
+  return _scl.getMicros();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::setSpeed(unsigned long hz) {
+  _speed = hz;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+unsigned long SWI2CBusCore<SDA_LINE, SCL_LINE>::getSpeed() {
+  return _achievedSpeed;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::wait(uint16_t loops) {
+  // Busy-wait delay, calibrated by calibrate(). Finer grained than delayMicroseconds().
+  if (loops) {    // Nothing added when running at SWI2C_SPEED_MAX
+    volatile uint16_t i = loops;
+    while (i) i--;
+  }
+}
+
+template <class SDA_LINE, class SCL_LINE>
+uint16_t SWI2CBusCore<SDA_LINE, SCL_LINE>::delayLoops(unsigned long ns, unsigned long loopTime) {
+  // Delay loop count for at least <ns>, given <loopTime> us per CALIBRATION_LOOPS loops
+  unsigned long loops;
+  const unsigned long scale = CALIBRATION_LOOPS / 1000;   // loops per ns, per us of loopTime
+  if (loopTime == 0) return 0;   // Simulated bus: delays take no time
+  if (ns / loopTime >= 65535UL / scale) return 65535U;
+  loops = (ns / loopTime) * scale + ((ns % loopTime) * scale + loopTime - 1) / loopTime;
+  return (loops > 65535UL) ? 65535U : loops;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+unsigned long SWI2CBusCore<SDA_LINE, SCL_LINE>::measureClocks() {
+  // Microseconds for CALIBRATION_CLOCKS SCL clocks with SDA released.
+  // Without a START, devices ignore these clocks.
+  unsigned long startTime;
+  sdaHi();
+  startTime = _scl.getMicros();
+  for (uint8_t i = 0; i < CALIBRATION_CLOCKS; i++) {
+    sclHi();
+    sclLo();
+  }
+  sclHi();
+  return _scl.getMicros() - startTime;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+unsigned long SWI2CBusCore<SDA_LINE, SCL_LINE>::calibrate() {
+  unsigned long clockNs, loopTime, startTime;
+  unsigned long lowNs, highNs;
+
+  // Cost of a clock with no delays, split evenly between the low and high periods
+  _lowDelay = 0;
+  _highDelay = 0;
+  clockNs = measureClocks() * 1000UL / CALIBRATION_CLOCKS;
+
+  if (_speed != SWI2C_SPEED_MAX) {
+    // Cost of the delay loop: microseconds for CALIBRATION_LOOPS loops
+    startTime = _scl.getMicros();
+    wait(CALIBRATION_LOOPS);
+    loopTime = _scl.getMicros() - startTime;
+
+    // Split the period 60% low / 40% high. This meets the minimum SCL low and
+    // high times for standard mode (4.7/4.0 us), fast mode (1.3/0.6 us), and
+    // fast mode plus (0.5/0.26 us).
+    lowNs = 1000000000UL / _speed * 6 / 10;
+    highNs = 1000000000UL / _speed * 4 / 10;
+    if (lowNs > clockNs / 2)  _lowDelay  = delayLoops(lowNs - clockNs / 2, loopTime);
+    if (highNs > clockNs / 2) _highDelay = delayLoops(highNs - clockNs / 2, loopTime);
+  }
+
+  // Measure the result
+  loopTime = measureClocks();
+  _achievedSpeed = loopTime ? CALIBRATION_CLOCKS * 1000000UL / loopTime : 0;
+  return _achievedSpeed;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+unsigned long SWI2CBusCore<SDA_LINE, SCL_LINE>::getStretchTimeout() {
+  return _stretch_timeout_delay;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::setStretchTimeout(unsigned long t) {
+  _stretch_timeout_delay = t;   // Not used if SWI2C_STRETCH_TIMEOUT is 0
+}
+
+template <class SDA_LINE, class SCL_LINE>
+int SWI2CBusCore<SDA_LINE, SCL_LINE>::checkStretchTimeout(){
+  int retval;
+  retval = _stretch_timeout_error;
+  // Clear the value upon reading it.
+  _stretch_timeout_error = 0;
+  return retval;
+}
+
+#if SWI2C_BUS_LOCK
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::acquire() {
+  bool waited = false;
+  while (!SWI2C_TRY_LOCK(&_lock)) waited = true;   // Empty loop: owned by another thread or core
+  if (_queue) {
+    SWI2C_STAT_ADD(_queue->_stats.acquisitions, 1);
+    if (waited) SWI2C_STAT_ADD(_queue->_stats.contentions, 1);
+  }
+}
+
+template <class SDA_LINE, class SCL_LINE>
+bool SWI2CBusCore<SDA_LINE, SCL_LINE>::tryAcquire() {
+  if (!SWI2C_TRY_LOCK(&_lock)) return false;
+  if (_queue) SWI2C_STAT_ADD(_queue->_stats.acquisitions, 1);
+  return true;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::release() {
+  SWI2C_Request request;
+  unsigned long waited;
+
+  for (;;) {
+    // Requests queued while the bus was owned run before it is freed, so
+    // each waits for at most one transaction
+    while (_queue && _queue->pop(request)) {
+      waited = getMicros() - request.queued;
+      if (waited > _queue->_stats.maxQueueWait) _queue->_stats.maxQueueWait = waited;   // Only set by the owner
+      SWI2C_STAT_ADD(_queue->_stats.totalQueueWait, waited);
+      runRequest(request);
+    }
+    SWI2C_UNLOCK(&_lock);
+    // With threads or a second core, a request can be queued after the
+    // queue was found empty and before the bus was freed. Take the bus
+    // back to run it. Not needed with interrupt handlers.
+    if (!_queue || _queue->isEmpty() || !SWI2C_TRY_LOCK(&_lock)) return;
+  }
+}
+
+template <class SDA_LINE, class SCL_LINE>
+bool SWI2CBusCore<SDA_LINE, SCL_LINE>::submit(SWI2C_Request& request) {
+  if (_queue) SWI2C_STAT_ADD(_queue->_stats.requests, 1);
+  if (tryAcquire()) {
+    runRequest(request);
+    release();
+    return true;
+  }
+  if (!_queue) return false;
+  request.queued = getMicros();
+  if (!_queue->push(request)) {
+    SWI2C_STAT_ADD(_queue->_stats.dropped, 1);
+    return false;
+  }
+  SWI2C_STAT_ADD(_queue->_stats.queued, 1);
+  // The owner may have freed the bus before the request was queued (only
+  // possible with threads or a second core), so make sure it is run
+  if (tryAcquire()) release();
+  return true;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+unsigned long SWI2CBusCore<SDA_LINE, SCL_LINE>::measureReads() {
+  // SCL reads per millisecond. The count doubles until the time is long
+  // enough to measure with the microsecond time source, but each count
+  // takes well under 1 ms, which micros() measures even in an AVR
+  // interrupt handler.
+  unsigned long startTime;
+  unsigned long elapsed;
+  uint16_t reads = 64;
+
+  for (;;) {
+    startTime = _scl.getMicros();
+    for (uint16_t i = 0; i < reads; i++) _scl.read();
+    elapsed = _scl.getMicros() - startTime;
+    if (elapsed >= 100 || reads >= 0x4000) break;
+    reads <<= 1;
+  }
+  if (elapsed == 0) elapsed = 1;
+  return reads * 1000UL / elapsed;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::runRequest(SWI2C_Request& request) {
+  // The request may run between the owner's transactions, so the owner's
+  // error state is kept. The callback sees the request's error state.
+  uint8_t lastError = _lastError;
+  uint8_t attempt = _attempt;
+  int timeoutError = _stretch_timeout_error;
+  int result;
+
+  _stretch_timeout_error = 0;
+#if SWI2C_STRETCH_TIMEOUT
+  if (_sclReadsPerMs == 0) _sclReadsPerMs = measureReads();
+#endif
+  _inRequest = true;
+  result = request.run(request);
+  _inRequest = false;
+  if (request.callback) request.callback(request.context, result);
+  _lastError = lastError;
+  _attempt = attempt;
+  _stretch_timeout_error = timeoutError;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::beginOwned() {
+  if (_open) _open = false;   // Continues a transaction that already owns the bus
+  else acquire();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::endOwned(bool open) {
+  if (open) _open = true;
+  else release();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CBusCore<SDA_LINE, SCL_LINE>::closeOwned() {
+  if (_open) {
+    _open = false;
+    release();
+  }
+}
+#endif
+
+
+// Basic high level methods
+// Each method describes its transaction to transact(): whether there is a
+// register address, and the data to write or the buffer to read into.
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeToRegister(uint8_t regAddress, uint8_t data, bool sendStopBit) {
+  SWI2C_Segment segment = {&data, 1, 0};
+  return transact(XFER_REGISTER, regAddress, &segment, 1, 0, 0, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeToRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit) { 
+  // Writes <count> bytes after sending device address and register address.
+  // Least significant byte is written first, ie. buffer[0] sent first
+  SWI2C_Segment segment = {buffer, count, 0};
+  return transact(XFER_REGISTER, regAddress, &segment, 1, 0, 0, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeToDevice(uint8_t data, bool sendStopBit) {
+  // Use with devices that do not use register addresses. 
+  SWI2C_Segment segment = {&data, 1, 0};
+  return transact(0, 0, &segment, 1, 0, 0, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeToDevice(uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // Use with devices that do not use register addresses. 
+  // Writes <count> bytes after sending device address.
+  // Least significant byte is written first, ie. buffer[0] sent first
+  SWI2C_Segment segment = {buffer, count, 0};
+  return transact(0, 0, &segment, 1, 0, 0, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeToRegister(uint8_t regAddress, const SWI2C_Segment* segments, uint8_t count, bool sendStopBit) {
+  // Writes the segments back to back after sending device address and register address.
+  return transact(XFER_REGISTER, regAddress, segments, count, 0, 0, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeToDevice(const SWI2C_Segment* segments, uint8_t count, bool sendStopBit) {
+  // Use this with devices that do not use register addresses.
+  // Writes the segments back to back after sending device address.
+  return transact(0, 0, segments, count, 0, 0, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::readFromRegister(uint8_t regAddress, uint8_t &data, bool sendStopBit) {
+  // This method uses pass-by-reference for the data byte
+  return readFromRegister(regAddress, &data, 1, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::readFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // Reads <count> bytes after sending device address and register address.
+  // Bytes are returned in <buffer>, which is assumed to be at least <count> bytes in size.
+  return transact(XFER_REGISTER | XFER_READ, regAddress, 0, 0, buffer, count, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::readFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                                                   unsigned long& timestamp, unsigned long& duration, bool sendStopBit) {
+  unsigned long times[2];
+  if (transact(XFER_REGISTER | XFER_READ, regAddress, 0, 0, buffer, count, sendStopBit, times) == 0) return 0;
+  timestamp = times[0];
+  duration = times[1] - times[0];
+  return 1;
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::readFromDevice(uint8_t &data, bool sendStopBit) {
+  // Use this with devices that do not use register addresses.
+  return readFromDevice(&data, 1, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::readFromDevice(uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // Use this with devices that do not use register addresses.
+  // Reads <count> bytes after sending device address.
+  // Bytes are returned in <buffer>, which is assumed to be at least <count> bytes in size.
+  return transact(XFER_READ, 0, 0, 0, buffer, count, sendStopBit);
+}
+
+// The transaction is a do/while loop around one attempt. A NACK ends the
+// attempt (nack() sends the STOP), and retry() decides whether to try
+// again under the bus's retry policy. By default there is a single attempt.
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::transact(uint8_t flags, uint8_t regAddress, const SWI2C_Segment* segments, uint8_t segmentCount,
+                                           uint8_t* buffer, uint8_t count, bool sendStopBit, unsigned long* times) {
+  uint8_t op = (flags & XFER_READ) ? SWI2C_OP_READ : SWI2C_OP_WRITE;
+
+  if (!beginOp(flags)) return endOp(op, 0, flags);   // Bus stuck
+  do {
+    if (select(flags, regAddress, times)) continue; // Immediately end transmission if NACK detected
+    if (flags & XFER_READ) readData(buffer, count);
+    else if (writeSegments(segments, segmentCount)) continue;
+    if (bus().finishAttempt(sendStopBit)) {
+      if (times) times[1] = bus().getMicros();
+      return endOp(op, 1, flags, sendStopBit);  // Return 1 if no NACKs
+    }
+  } while (bus().retry());
+  return endOp(op, 0, flags);
+}
+
+template <class DERIVED, class BUS>
+bool SWI2CDeviceAPI<DERIVED, BUS>::select(uint8_t flags, uint8_t regAddress, unsigned long* times) {
+  // START, device address, and register address if any. For a read, ends
+  // with the read address. Returns true if a NACK ended the transaction.
+  startBit();
+  if (flags & XFER_REGISTER) {
+    writeAddress(0); // 0 == Write bit
+    if (nack(SWI2C_PHASE_ADDRESS)) return true;
+    writeRegister(regAddress);
+    if (nack(SWI2C_PHASE_REGISTER)) return true;
+    if (!(flags & XFER_READ)) return false;
+    startBit();    // Repeated START to change direction
+  }
+  if (times) times[0] = bus().getMicros();
+  writeAddress((flags & XFER_READ) ? 1 : 0);
+  return nack(SWI2C_PHASE_ADDRESS);
+}
+
+template <class DERIVED, class BUS>
+SWI2CDeviceAPI<DERIVED, BUS>::SWI2CDeviceAPI(uint8_t deviceID) : _deviceID(deviceID) {
+#if SWI2C_STATS
+  _stats.reset();
+  _opStart = 0;
+#endif
+}
+
+template <class DERIVED, class BUS>
+bool SWI2CDeviceAPI<DERIVED, BUS>::beginOp(uint8_t flags) {
+#if SWI2C_BUS_LOCK
+  if (!(flags & XFER_OWNED)) bus().beginOwned();
+#else
+  (void)flags;
+#endif
+#if SWI2C_STATS
+  _opStart = bus().getMicros();
+  bus().setStatsTarget(&_stats);
+#endif
+  return bus().beginAttempts();
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::endOp(uint8_t op, int result, uint8_t flags, bool sendStopBit) {
+  // Records the statistics for a high level method, frees the bus unless
+  // the transaction was left open, and returns <result>
+#if SWI2C_STATS
+  _stats.transactions[op]++;
+  if (result == 0) _stats.failures[op]++;
+  _stats.retries += bus().getAttempts() - 1;
+  _stats.latency[op][SWI2C_Stats::bucket(bus().getMicros() - _opStart)]++;
+  bus().setStatsTarget(0);
+#else
+  (void)op;
+#endif
+#if SWI2C_BUS_LOCK
+  if (!(flags & XFER_OWNED)) bus().endOwned(result && !sendStopBit);   // A failed transaction always ends with a STOP
+#else
+  (void)flags;
+  (void)sendStopBit;
+#endif
+  return result;
+}
+
+template <class DERIVED, class BUS>
+bool SWI2CDeviceAPI<DERIVED, BUS>::nack(uint8_t phase) {
+  // Reads the ACK bit. On a NACK, ends the transaction and records the error for <phase>.
+  if (checkAckBit() == 0) {
+#if SWI2C_STATS
+    if (phase != SWI2C_PHASE_ADDRESS) _stats.bytesOut++;
+#endif
+    return false;
+  }
+#if SWI2C_STATS
+  _stats.nacks[phase]++;
+#endif
+  bus().attemptFailed(phase == SWI2C_PHASE_ADDRESS ? SWI2C_MSG_ADDRESS_NACK : SWI2C_MSG_DATA_NACK);
+  return true;
+}
+
+template <class DERIVED, class BUS>
+bool SWI2CDeviceAPI<DERIVED, BUS>::writeData(const uint8_t* buffer, uint16_t count, bool progmem) {
+  // Writes <count> bytes, checking the ACK after each. Returns true if a NACK ended the transaction.
+  for (uint16_t i = 0; i < count; i++) {
+    writeByte(progmem ? SWI2C_READ_PROGMEM(buffer + i) : buffer[i]);
+    if (nack(SWI2C_PHASE_DATA)) return true; // Immediately end transmission if NACK detected
+  }
+  return false;
+}
+
+template <class DERIVED, class BUS>
+bool SWI2CDeviceAPI<DERIVED, BUS>::writeSegments(const SWI2C_Segment* segments, uint8_t count) {
+  // Writes each segment in turn. Returns true if a NACK ended the transaction.
+  for (uint8_t i = 0; i < count; i++) {
+    if (writeData(segments[i].data, segments[i].len, segments[i].flags & SWI2C_SEG_PROGMEM)) return true;
+  }
+  return false;
+}
+
+template <class DERIVED, class BUS>
+void SWI2CDeviceAPI<DERIVED, BUS>::readData(uint8_t* buffer, uint8_t count) {
+#if SWI2C_STATS
+  _stats.bytesIn += count;
+#endif
+  // Loop through bytes in the buffer
+  for (uint8_t i = 0; i < count; i++) {
+    buffer[i] = read1Byte();
+    if (i < (count-1)) {
+      writeAck();
+    }
+    else { // Last byte needs a NACK
+      checkAckBit(); // Controller needs to send NACK when done reading data
+    }
+  }
+}
+
+#if SWI2C_LEGACY_API
+// Other high level methods for more specific use cases
+// write1bToRegister is here for backwards compatibility with older versions of the library
+// New code should use writeToRegister()
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::write1bToRegister(uint8_t regAddress, uint8_t data, bool sendStopBit) {
+  return writeToRegister(regAddress, data, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::write2bToRegister(uint8_t regAddress, uint16_t data, bool sendStopBit) {
+  // LEAST significant BYTE is transferred first
+  // If device is expecting MSB first, use write2bToRegisterMSBFirst()
+  return writeValue<2, SWI2C_LSB_FIRST>(regAddress, data, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::write2bToRegisterMSBFirst(uint8_t regAddress, uint16_t data, bool sendStopBit) {
+  return writeValue<2, SWI2C_MSB_FIRST>(regAddress, data, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeBytesToRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // writeBytesToRegister is here for backwards compatibility with older versions of the library
+  // New code should use writeToRegister()
+  // Least significant byte is written first, ie. buffer[0] sent first
+  return writeToRegister(regAddress, buffer, count, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::write1bToDevice(uint8_t data, bool sendStopBit) {
+  // write1bToDevice is here for backwards compatibility with older versions of the library
+  // New code should use writeToDevice()
+  // Use with devices that do not use register addresses. 
+  return writeToDevice(data, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeBytesToDevice(uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // writeBytesToDevice is here for backwards compatibility with older versions of the library
+  // New code should use writeToDevice()
+  // Use with devices that do not use register addresses. 
+  // Writes <count> bytes after sending device address.
+  // Least significant byte is written first, ie. buffer[0] sent first
+  return writeToDevice(buffer, count, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::read1bFromRegister(uint8_t regAddress, uint8_t* data, bool sendStopBit) {
+  return readFromRegister(regAddress, data, 1, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::read2bFromRegister(uint8_t regAddress, uint16_t* data, bool sendStopBit) {
+  // Returns first byte received in LSB. If MSB is first, then use read2bFromRegisterMSBFirst()
+  return readValue<2, SWI2C_LSB_FIRST>(regAddress, *data, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::read2bFromRegisterMSBFirst(uint8_t regAddress, uint16_t* data, bool sendStopBit) {
+  // First byte received is placed in the MSB as it is read
+  return readValue<2, SWI2C_MSB_FIRST>(regAddress, *data, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::readBytesFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // readBytesFromRegister is here for backwards compatibility with older versions of the library
+  // New code should use readFromRegister()
+  // Bytes are returned in <buffer>, which is assumed to be at least <count> bytes in size.
+  return readFromRegister(regAddress, buffer, count, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::read1bFromDevice(uint8_t* data, bool sendStopBit){
+  // Use this with devices that do not use register addresses.
+  return readFromDevice(data, 1, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::readBytesFromDevice(uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // readBytesFromDevice is here for backwards compatibility with older versions of the library
+  // New code should use readFromDevice()
+  // Use this with devices that do not use register addresses.
+  // Reads <count> bytes after sending device address.
+  // Bytes are returned in <buffer>, which is assumed to be at least <count> bytes in size.
+  return readFromDevice(buffer, count, sendStopBit);
+}
+#endif
+
+template <class DERIVED, class BUS>
+template <uint8_t BYTES, uint8_t ORDER>
+int SWI2CDeviceAPI<DERIVED, BUS>::readValue(uint8_t regAddress, typename SWI2C_RegType<BYTES, false>::type& raw, bool sendStopBit) {
+  // Reads a BYTES byte value from <regAddress>, assembled in the given byte
+  // order as it is received: each byte is shifted into place as it is read,
+  // so there is no buffer and no swap afterwards
+  typedef typename SWI2C_RegType<BYTES, false>::type T;
+  T value;
+
+  if (!beginOp()) return endOp(SWI2C_OP_READ, 0);   // Bus stuck
+  do {
+    if (select(XFER_REGISTER | XFER_READ, regAddress)) continue; // Immediately end transmission if NACK detected
+    value = 0;
+    for (uint8_t i = 0; i < BYTES; i++) {
+      value |= (T)read1Byte() << (8 * (ORDER == SWI2C_MSB_FIRST ? BYTES - 1 - i : i));
+      if (i < BYTES - 1) writeAck();
+      else checkAckBit(); // Controller needs to send NACK when done reading data
+    }
+#if SWI2C_STATS
+    _stats.bytesIn += BYTES;
+#endif
+    if (bus().finishAttempt(sendStopBit)) {
+      raw = value;
+      return endOp(SWI2C_OP_READ, 1, 0, sendStopBit);  // Return 1 if no NACKs
+    }
+  } while (bus().retry());
+  return endOp(SWI2C_OP_READ, 0);
+}
+
+template <class DERIVED, class BUS>
+template <uint8_t BYTES, uint8_t ORDER>
+int SWI2CDeviceAPI<DERIVED, BUS>::writeValue(uint8_t regAddress, typename SWI2C_RegType<BYTES, false>::type raw, bool sendStopBit) {
+  // Writes a BYTES byte value to <regAddress> in the given byte order
+  uint8_t buffer[BYTES];
+  for (uint8_t i = 0; i < BYTES; i++) {
+    buffer[ORDER == SWI2C_MSB_FIRST ? BYTES - 1 - i : i] = (uint8_t)(raw >> (8 * i));
+  }
+  return writeToRegister(regAddress, buffer, BYTES, sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+template <class REG>
+int SWI2CDeviceAPI<DERIVED, BUS>::read(typename REG::type& value, bool sendStopBit) {
+  typename REG::raw_type raw;
+  (void)sizeof(SWI2C_Check<(REG::access & SWI2C_RO) != 0>);   // Compile error if write-only
+  if (readValue<REG::bytes, REG::order>(REG::address, raw, sendStopBit) == 0) return 0;
+  value = REG::fromRaw(raw);
+  return 1;
+}
+
+template <class DERIVED, class BUS>
+template <class REG>
+int SWI2CDeviceAPI<DERIVED, BUS>::write(typename REG::type value, bool sendStopBit) {
+  (void)sizeof(SWI2C_Check<(REG::access & SWI2C_WO) != 0>);   // Compile error if read-only
+  return writeValue<REG::bytes, REG::order>(REG::address, REG::toRaw(value), sendStopBit);
+}
+
+template <class DERIVED, class BUS>
+template <class REG>
+int SWI2CDeviceAPI<DERIVED, BUS>::update(typename REG::type mask, typename REG::type value) {
+  typename REG::type current;
+  if (read<REG>(current) == 0) return 0;
+  return write<REG>((typename REG::type)((current & ~mask) | (value & mask)));
+}
+
+
+template <class DERIVED, class BUS>
+uint16_t SWI2CDeviceAPI<DERIVED, BUS>::streamFromRegister(uint8_t regAddress, SWI2CRing& ring, uint16_t count, bool sendStopBit) {
+  // Reads up to <count> bytes in one transaction, storing each byte directly in <ring>.
+  // Reads fewer bytes if the ring does not have space for <count>. Intended for
+  // FIFO data registers, which do not auto-increment.
+  uint16_t space = ring.space();
+  if (count > space) count = space;
+  if (count == 0) {
+    if (sendStopBit) stopBit();   // End a transaction left open by drainFIFO() or the caller
+    return 0;
+  }
+
+  // Only the address phase is retried: once FIFO bytes have been read, they
+  // are gone from the device, so reading again would lose them.
+  if (!beginOp()) return endOp(SWI2C_OP_READ, 0);   // Bus stuck
+  while (select(XFER_REGISTER | XFER_READ, regAddress)) {  // NACK ended the transaction
+    if (!bus().retry()) return endOp(SWI2C_OP_READ, 0);
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    ring.write(read1Byte());
+    if (i < (count-1)) {
+      writeAck();
+    }
+    else { // Last byte needs a NACK
+      checkAckBit(); // Controller needs to send NACK when done reading data
+    }
+  }
+#if SWI2C_STATS
+  _stats.bytesIn += count;
+#endif
+  // A stretch timeout is reported by getLastError(), but the bytes are still returned
+  endOp(SWI2C_OP_READ, bus().finishAttempt(sendStopBit) ? 1 : 0, 0, sendStopBit);
+  return count;
+}
+
+template <class DERIVED, class BUS>
+uint16_t SWI2CDeviceAPI<DERIVED, BUS>::drainFIFO(uint8_t countRegAddress, uint8_t dataRegAddress, SWI2CRing& ring, bool countMSBFirst) {
+  // Reads the 2-byte FIFO count register, then that many bytes (or as many
+  // as fit in <ring>) from the FIFO data register, using a repeated START.
+  uint16_t count;
+  int result;
+  if (countMSBFirst) result = readValue<2, SWI2C_MSB_FIRST>(countRegAddress, count, false);
+  else result = readValue<2, SWI2C_LSB_FIRST>(countRegAddress, count, false);
+  if (result == 0) return 0;
+  return streamFromRegister(dataRegAddress, ring, count);
+}
+
+#if SWI2C_BUS_LOCK
+template <class DERIVED, class BUS>
+bool SWI2CDeviceAPI<DERIVED, BUS>::requestFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                                                       SWI2C_RequestCallback callback, void* context) {
+  return makeRequest(XFER_REGISTER | XFER_READ, regAddress, buffer, count, callback, context);
+}
+
+template <class DERIVED, class BUS>
+bool SWI2CDeviceAPI<DERIVED, BUS>::requestToRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                                                     SWI2C_RequestCallback callback, void* context) {
+  return makeRequest(XFER_REGISTER, regAddress, buffer, count, callback, context);
+}
+
+template <class DERIVED, class BUS>
+bool SWI2CDeviceAPI<DERIVED, BUS>::makeRequest(uint8_t flags, uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                                               SWI2C_RequestCallback callback, void* context) {
+  // Copied into the queue if the bus is busy
+  SWI2C_Request request;
+  request.run = runRequest;
+  request.device = this;
+  request.buffer = buffer;
+  request.count = count;
+  request.regAddress = regAddress;
+  request.flags = flags | XFER_OWNED;
+  request.callback = callback;
+  request.context = context;
+  request.queued = 0;
+  return bus().submit(request);
+}
+
+template <class DERIVED, class BUS>
+int SWI2CDeviceAPI<DERIVED, BUS>::runRequest(SWI2C_Request& request) {
+  // Called by the bus, which is already owned, to run the transaction
+  SWI2CDeviceAPI* device = static_cast<SWI2CDeviceAPI*>(request.device);
+  SWI2C_Segment segment = {request.buffer, request.count, 0};
+  if (request.flags & XFER_READ) {
+    return device->transact(request.flags, request.regAddress, 0, 0, request.buffer, request.count, true);
+  }
+  return device->transact(request.flags, request.regAddress, &segment, 1, 0, 0, true);
+}
+#endif
+
+template <class DERIVED, class BUS>
+void SWI2CDeviceAPI<DERIVED, BUS>::stopBit() {
+  bus().stopBit();
+#if SWI2C_BUS_LOCK
+  bus().closeOwned();   // Frees the bus if this ends a transaction left open by a high level method
+#endif
+}
+
+#if SWI2C_STATS
+template <class DERIVED, class BUS>
+void SWI2CDeviceAPI<DERIVED, BUS>::snapshotStats(SWI2C_Stats& snapshot, bool reset) {
+  snapshot = _stats;
+  if (reset) _stats.reset();
+}
+#endif
+
+template <class DERIVED, class BUS>
+uint8_t SWI2CDeviceAPI<DERIVED, BUS>::getDeviceID() {
+  return _deviceID;
+}
+
+template <class DERIVED, class BUS>
+void SWI2CDeviceAPI<DERIVED, BUS>::setDeviceID(uint8_t deviceid) {
+  // deviceid is the 7-bit I2C address
+  _deviceID = deviceid;
+}
+
+#endif
@@ -0,0 +1,237 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - EEPROM page writes with ACK polling
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Own the bus for each operation (SWI2C_BUS_LOCK)
+   10/16/2026 - Andy4495 - Fail with SWI2C_MSG_BUS_STUCK if SDA is stuck low
+   10/16/2026 - Andy4495 - Free the bus between pages in write()
+   10/16/2026 - Andy4495 - Continue a transaction left open by a high level method
+   10/16/2026 - Andy4495 - Report only this operation's stretch timeout
+   10/16/2026 - Andy4495 - Treat a page size of 0 as 1
+*/
+/* -----------------------------------------------------------------
+   SWI2CEEPROM reads and writes 24Cxx-class serial EEPROMs (and other
+   memory devices with the same protocol) of any size:
+
+     SWI2C myDevice(SDA_PIN, SCL_PIN, 0x50);
+     SWI2CEEPROM<SWI2C> eeprom(myDevice, 64, 2);   // 24C256: 64-byte pages, 16-bit addresses
+     eeprom.write(0x0100, config, sizeof(config));
+     eeprom.read(0x0100, config, sizeof(config));
+
+   Memory addresses are sent as 1 or 2 bytes, MSB first. Address bits
+   above those (for example A8-A10 of a 24C16, or A16 of a 24CM01) are
+   added to the device address, so myDevice should have the base
+   device address with those bits clear.
+
+   write() splits the data on page boundaries and writes one page per
+   transaction. After each page, instead of a fixed delay, the device
+   address is sent repeatedly until the device ACKs it (ACK polling), so
+   the next page starts as soon as the write cycle is finished. write()
+   returns after the last write cycle is finished. read() reads any
+   number of bytes in one sequential read.
+
+   read() owns the bus until it returns (see SWI2C_Lock.h). write()
+   frees the bus after the STOP of each page, and owns it again for the
+   ACK polling and the next page. Requests from interrupt handlers that
+   are queued during a page run right after its STOP. A request queued
+   during ACK polling waits until the write cycle is finished and the
+   next page is written: up to one write cycle (5 to 10 ms for a
+   24Cxx) plus one page. Other threads or cores can take the bus
+   between pages.
+
+   DEVICE is any SWI2C device class (SWI2C, SWI2CT, SWI2CDevice, ...).
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_EEPROM_H
+#define SWI2C_EEPROM_H
+
+#include "Arduino.h"
+#include "SWI2C_Config.h"
+
+#define SWI2C_EEPROM_WRITE_TIMEOUT  10UL   // ms to wait for a write cycle (24Cxx maximum is 5 to 10 ms)
+
+template <class DEVICE>
+class SWI2CEEPROM {
+public:
+  // A <pageSize> of 0 is treated as 1: each byte is written on its own
+  SWI2CEEPROM(DEVICE& device, uint16_t pageSize, uint8_t addressBytes = 2,
+              unsigned long writeTimeout = SWI2C_EEPROM_WRITE_TIMEOUT);
+
+  // Same return codes as the SWI2C high level methods: 1 if successful, 0 if not.
+  // getLastError() has the reason.
+  int read(uint32_t address, uint8_t* buffer, uint16_t count);
+  int write(uint32_t address, const uint8_t* buffer, uint16_t count);
+  // Waits until the device ACKs its address, or the write timeout
+  int waitReady();
+
+  // SWI2C_MSG_ADDRESS_NACK: device not ready within the write timeout (or absent)
+  // SWI2C_MSG_DATA_NACK: memory address or data byte not ACKed (e.g. write protected)
+  // SWI2C_MSG_STRETCH_TIMEOUT: clock-stretching timeout
+  // SWI2C_MSG_BUS_STUCK: SDA held low by a device, and recover() could not free it
+  uint8_t getLastError() {return _lastError;}
+  // Address probes NACKed while waiting for write cycles during the last write()
+  uint16_t getPolls() {return _polls;}
+
+private:
+  uint8_t select(uint32_t address, uint8_t r_w, bool poll);
+  uint8_t selectAddress(uint32_t address);
+  uint8_t ready();
+  bool own();
+  void nextPage();
+  int finish(uint8_t result);
+
+  DEVICE* _device;
+  uint16_t _pageSize;
+  uint8_t _addressBytes;
+  unsigned long _writeTimeout;
+  uint8_t _lastError;
+  uint16_t _polls;
+};
+
+template <class DEVICE>
+SWI2CEEPROM<DEVICE>::SWI2CEEPROM(DEVICE& device, uint16_t pageSize, uint8_t addressBytes, unsigned long writeTimeout) {
+  _device = &device;
+  _pageSize = pageSize ? pageSize : 1;   // write() splits the data at multiples of the page size
+  _addressBytes = addressBytes;
+  _writeTimeout = writeTimeout;
+  _lastError = SWI2C_MSG_OK;
+  _polls = 0;
+}
+
+template <class DEVICE>
+uint8_t SWI2CEEPROM<DEVICE>::select(uint32_t address, uint8_t r_w, bool poll) {
+  // START and device address, including any memory address bits above the
+  // address bytes. With <poll>, repeats both until the device ACKs or the write timeout.
+  uint8_t id = _device->getDeviceID() | (uint8_t)(address >> (8 * _addressBytes));
+  unsigned long startTimer = _device->getBus().getMillis();
+
+  for (;;) {
+    _device->startBit();   // Repeated START between probes
+    _device->getBus().writeAddress(id, r_w);
+    if (_device->checkAckBit() == 0) return SWI2C_MSG_OK;
+    if (!poll || _device->getBus().getMillis() - startTimer >= _writeTimeout) {
+      _device->stopBit();
+      return SWI2C_MSG_ADDRESS_NACK;
+    }
+    _polls++;
+  }
+}
+
+template <class DEVICE>
+uint8_t SWI2CEEPROM<DEVICE>::selectAddress(uint32_t address) {
+  // Sends the memory address after the device address
+  if (_addressBytes == 2) {
+    _device->writeByte((address >> 8) & 0xFF);
+    if (_device->checkAckBit()) {
+      _device->stopBit();
+      return SWI2C_MSG_DATA_NACK;
+    }
+  }
+  _device->writeByte(address & 0xFF);
+  if (_device->checkAckBit()) {
+    _device->stopBit();
+    return SWI2C_MSG_DATA_NACK;
+  }
+  return SWI2C_MSG_OK;
+}
+
+template <class DEVICE>
+bool SWI2CEEPROM<DEVICE>::own() {
+  // Every operation ends with finish(), which frees the bus. Returns false
+  // if the bus is stuck.
+#if SWI2C_BUS_LOCK
+  _device->getBus().beginOwned();   // Continues a transaction left open by a high level method
+#endif
+  return _device->getBus().beginAttempts();
+}
+
+template <class DEVICE>
+void SWI2CEEPROM<DEVICE>::nextPage() {
+  // Frees the bus after a page's STOP, which runs any queued requests,
+  // then owns it again for the ACK polling
+#if SWI2C_BUS_LOCK
+  _device->getBus().endOwned(false);
+  _device->getBus().beginOwned();
+#endif
+}
+
+template <class DEVICE>
+int SWI2CEEPROM<DEVICE>::finish(uint8_t result) {
+  // The STOP has been sent. A stretch timeout during this operation
+  // replaces <result>. The checkStretchTimeout() flag is left for the caller.
+  if (result != SWI2C_MSG_BUS_STUCK && !_device->getBus().finishAttempt(false)) {
+    result = _device->getBus().getLastError();
+  }
+#if SWI2C_BUS_LOCK
+  _device->getBus().endOwned(false);
+#endif
+  _lastError = result;
+  return result == SWI2C_MSG_OK;
+}
+
+template <class DEVICE>
+int SWI2CEEPROM<DEVICE>::read(uint32_t address, uint8_t* buffer, uint16_t count) {
+  uint8_t result;
+
+  if (!own()) return finish(SWI2C_MSG_BUS_STUCK);
+  if (count == 0) return finish(SWI2C_MSG_OK);
+  result = select(address, 0, false);
+  if (result == SWI2C_MSG_OK) result = selectAddress(address);
+  if (result == SWI2C_MSG_OK) result = select(address, 1, false);
+  if (result != SWI2C_MSG_OK) return finish(result);
+  for (uint16_t i = 0; i < count; i++) {
+    buffer[i] = _device->read1Byte();
+    if (i < count - 1) _device->writeAck();
+    else _device->checkAckBit();   // NACK the last byte
+  }
+  _device->stopBit();
+  return finish(SWI2C_MSG_OK);
+}
+
+template <class DEVICE>
+int SWI2CEEPROM<DEVICE>::write(uint32_t address, const uint8_t* buffer, uint16_t count) {
+  uint16_t n;
+  uint8_t result;
+
+  _polls = 0;
+  if (!own()) return finish(SWI2C_MSG_BUS_STUCK);
+  while (count) {
+    // Bytes left in this page
+    n = _pageSize - address % _pageSize;
+    if (n > count) n = count;
+    result = select(address, 0, true);   // Waits for the previous page's write cycle
+    if (result == SWI2C_MSG_OK) result = selectAddress(address);
+    if (result != SWI2C_MSG_OK) return finish(result);
+    for (uint16_t i = 0; i < n; i++) {
+      _device->writeByte(buffer[i]);
+      if (_device->checkAckBit()) {
+        _device->stopBit();
+        return finish(SWI2C_MSG_DATA_NACK);
+      }
+    }
+    _device->stopBit();   // Starts the write cycle
+    address += n;
+    buffer += n;
+    count -= n;
+    nextPage();
+  }
+  return finish(ready());
+}
+
+template <class DEVICE>
+int SWI2CEEPROM<DEVICE>::waitReady() {
+  if (!own()) return finish(SWI2C_MSG_BUS_STUCK);
+  return finish(ready());
+}
+
+template <class DEVICE>
+uint8_t SWI2CEEPROM<DEVICE>::ready() {
+  uint8_t result = select(0, 0, true);
+  if (result == SWI2C_MSG_OK) _device->stopBit();
+  return result;
+}
+
+#endif
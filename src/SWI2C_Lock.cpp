@@ -0,0 +1,39 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Bus ownership for interrupt handlers
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+
+#include "SWI2C_Lock.h"
+
+SWI2C_RequestQueue::SWI2C_RequestQueue(SWI2C_Request* entries, uint8_t size) {
+  _entries = entries;
+  _size = size;
+  _head = 0;
+  _tail = 0;
+  resetStats();
+}
+
+bool SWI2C_RequestQueue::push(const SWI2C_Request& request) {
+  uint8_t next = (_head + 1 == _size) ? 0 : _head + 1;
+  if (next == _tail) return false;
+  _entries[_head] = request;
+  SWI2C_BARRIER();    // Entry is complete before the owner can see it
+  _head = next;
+  return true;
+}
+
+bool SWI2C_RequestQueue::pop(SWI2C_Request& request) {
+  uint8_t tail = _tail;
+  if (_head == tail) return false;
+  request = _entries[tail];
+  SWI2C_BARRIER();    // Entry is copied before the handler can reuse it
+  _tail = (tail + 1 == _size) ? 0 : tail + 1;
+  return true;
+}
+
+void SWI2C_RequestQueue::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+}
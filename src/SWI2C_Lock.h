@@ -0,0 +1,134 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Bus ownership for interrupt handlers
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Requests do not use the time source for retry backoff or stretch timeout
+   10/16/2026 - Andy4495 - Update the lock statistics atomically
+*/
+/* -----------------------------------------------------------------
+   Each bus has a lock, taken by the high level methods, transfer(),
+   scan(), and rescan() for each transaction and freed after its STOP.
+   An interrupt handler must not call those methods, since it would wait
+   forever for a transaction that it interrupted. Instead, it makes a
+   request, which never waits:
+
+     SWI2C_Request entries[4];
+     SWI2C_RequestQueue queue(entries, 4);
+     ...
+     bus.setRequestQueue(&queue);
+     attachInterrupt(digitalPinToInterrupt(INT_PIN), onDataReady, RISING);
+
+     void onDataReady() {
+       imu.requestFromRegister(0x3B, sample, 6, onSample);
+     }
+
+   If the bus is free, the request runs right away in the handler. If
+   not, it is queued, and the code that owns the bus runs it right after
+   the STOP of its transaction, before returning. Either way, the
+   callback is called with the result when it is done.
+
+   The time source (millis() on AVR) may not advance in an interrupt
+   handler, so a request does not wait for the retry backoff, and counts
+   its clock-stretching timeout in SCL reads, at the rate measured by
+   the first request, instead of in milliseconds.
+
+   The lock is taken with a single test-and-set. Where the compiler has
+   a lock-free atomic test-and-set (for example, ARM Cortex-M3 and up,
+   ESP32, and host PCs), that is used. Otherwise (for example, AVR and
+   MSP430), an interrupt handler runs to completion before the code it
+   interrupted continues, so a plain check and set of the lock byte is
+   enough. The lock never disables interrupts. One interrupt handler at
+   a time may make requests for a given bus (handlers that can interrupt
+   each other must use different buses).
+
+   The lock statistics are counted both by the bus owner and by requests
+   in interrupt handlers. On AVR, each update is made with interrupts
+   disabled for a few cycles, as the direct pin driver does, so that a
+   handler cannot lose a count part way through a 32-bit add. Where the
+   compiler has lock-free atomic adds, those are used instead.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_LOCK_H
+#define SWI2C_LOCK_H
+
+#include "Arduino.h"
+#include "SWI2C_Config.h"
+
+#if defined(__GCC_ATOMIC_BOOL_LOCK_FREE) && (__GCC_ATOMIC_BOOL_LOCK_FREE == 2)
+#define SWI2C_TRY_LOCK(lock)  (!__atomic_test_and_set((lock), __ATOMIC_ACQUIRE))
+#define SWI2C_UNLOCK(lock)    __atomic_clear((lock), __ATOMIC_RELEASE)
+#define SWI2C_BARRIER()       __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define SWI2C_TRY_LOCK(lock)  (*(lock) ? false : (*(lock) = true))
+#define SWI2C_UNLOCK(lock)    (*(lock) = false)
+#define SWI2C_BARRIER()       __asm__ __volatile__("" ::: "memory")
+#endif
+
+#if defined(__AVR__)
+#define SWI2C_STAT_ADD(stat, n)  do {uint8_t oldSREG = SREG; cli(); (stat) += (n); SREG = oldSREG;} while (0)
+#elif defined(__GCC_ATOMIC_INT_LOCK_FREE) && (__GCC_ATOMIC_INT_LOCK_FREE == 2) && \
+      defined(__GCC_ATOMIC_LONG_LOCK_FREE) && (__GCC_ATOMIC_LONG_LOCK_FREE == 2)
+#define SWI2C_STAT_ADD(stat, n)  __atomic_fetch_add(&(stat), (n), __ATOMIC_RELAXED)
+#else
+#define SWI2C_STAT_ADD(stat, n)  ((stat) += (n))
+#endif
+
+// Called when a request is done, with the same result as the high level
+// method it replaces: 1 if successful, 0 if not (getLastError() has the reason).
+typedef void (*SWI2C_RequestCallback)(void* context, int result);
+
+// A transaction requested from an interrupt handler. Filled in by the
+// device's request methods (requestFromRegister(), requestToRegister()).
+struct SWI2C_Request {
+  int (*run)(SWI2C_Request& request);   // Runs the transaction on <device>
+  void* device;
+  uint8_t* buffer;
+  uint8_t count;
+  uint8_t regAddress;
+  uint8_t flags;
+  SWI2C_RequestCallback callback;
+  void* context;                        // Passed to the callback
+  unsigned long queued;                 // micros() when queued
+};
+
+struct SWI2C_LockStats {
+  uint32_t acquisitions;      // Transactions and requests that took the bus
+  uint32_t contentions;       // Times a high level method or transfer waited for the bus
+  uint32_t requests;          // Requests made
+  uint32_t queued;            // Requests that found the bus busy and were queued
+  uint32_t dropped;           // Requests refused because the queue was full
+  unsigned long maxQueueWait;     // Longest time in us from queueing a request to running it
+  unsigned long totalQueueWait;   // Sum of the queue waits, for the mean (totalQueueWait / queued)
+};
+
+template <class SDA_LINE, class SCL_LINE> class SWI2CBusCore;
+
+// Requests waiting for the bus, over caller-supplied storage. A queue of
+// <size> entries holds up to <size> - 1 requests. Requests are added by
+// the interrupt handler and removed by the bus owner, so no lock is needed.
+// Also keeps the lock statistics for the bus it is attached to.
+class SWI2C_RequestQueue {
+public:
+  SWI2C_RequestQueue(SWI2C_Request* entries, uint8_t size);
+
+  bool push(const SWI2C_Request& request);   // False if full
+  bool pop(SWI2C_Request& request);          // False if empty
+  bool isEmpty() {return _head == _tail;}
+
+  const SWI2C_LockStats& getStats() {return _stats;}
+  void resetStats();
+
+private:
+  template <class SDA_LINE, class SCL_LINE> friend class SWI2CBusCore;
+
+  SWI2C_Request* _entries;
+  uint8_t _size;
+  volatile uint8_t _head;     // Next entry written
+  volatile uint8_t _tail;     // Next entry read
+  SWI2C_LockStats _stats;
+};
+
+#endif
@@ -0,0 +1,13 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Bit-parallel access to identical devices
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+
+#include "SWI2C_Multi.h"
+
+SWI2CMulti::SWI2CMulti(const uint8_t* sda_pins, uint8_t laneCount, uint8_t scl_pin, uint8_t deviceID) :
+  SWI2CMultiCore<SWI2C_PinLanes, SWI2C_PinLine>(SWI2C_PinLanes(sda_pins, laneCount), SWI2C_PinLine(scl_pin), deviceID) {
+}
@@ -0,0 +1,252 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Bit-parallel access to identical devices
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   SWI2CMulti talks to up to SWI2C_MAX_LANES identical devices at the
+   same address, each on its own SDA pin ("lane"), with one shared SCL
+   pin. Every lane is clocked in the same transaction, so reading N
+   devices takes about as long as reading one:
+
+     const uint8_t sdaPins[] = {2, 3, 4, 5};
+     SWI2CMulti sensors(sdaPins, 4, SCL_PIN, 0x48);
+     uint8_t data[4 * 2];
+     uint8_t ok = sensors.readFromRegister(0x00, data, 2);  // data[lane * 2 + i]
+
+   The same address, register, and data are written to every lane. Reads
+   return one value per lane. The high level methods return a mask of
+   the lanes (bit n = lane n) where the device ACKed everything; a lane
+   that NACKs is released for the rest of the transaction. Lanes can be
+   left out with setLanes().
+
+   With the DIRECT pin driver on AVR, put all the SDA pins on the same
+   port: each edge is then one port write and each bit is one port read
+   for all lanes.
+
+   The bus methods inherited from SWI2CBusCore (startBit(), writeByte(),
+   setSpeed(), setStretchTimeout(), ...) act on all active lanes.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_MULTI_H
+#define SWI2C_MULTI_H
+
+#include "Arduino.h"
+#include "SWI2C_PinDriver.h"
+#include "SWI2C_Core.h"
+
+// LANES is a lanes driver (SWI2C_PinLanes or SWI2C_SimLanes): an SDA line
+// class that also provides readAll(), laneBit(), setActive(), getActive(),
+// and getLaneCount().
+template <class LANES, class SCL_LINE>
+class SWI2CMultiCore : public SWI2CBusCore<LANES, SCL_LINE> {
+public:
+  SWI2CMultiCore(const LANES& sda, const SCL_LINE& scl, uint8_t deviceID);
+  void begin();
+
+  // High level methods. Return the lanes that completed without a NACK.
+  // <buffer> holds <count> bytes per lane: buffer[lane * count + i]
+  uint8_t writeToRegister(uint8_t regAddress, uint8_t data, bool sendStopBit = true);
+  uint8_t writeToRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit = true);
+  uint8_t readFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit = true);
+  uint8_t readFromDevice(uint8_t* buffer, uint8_t count, bool sendStopBit = true);
+
+  // Low level methods for lanes
+  // Reads the ACK bit on every active lane. Lanes that NACK are released and
+  // dropped from the rest of the transaction. Returns the lanes still active.
+  uint8_t checkAckLanes();
+  // Reads one byte from every lane into data[lane]. Lanes that are not active read 0xFF.
+  void readLanes(uint8_t* data);
+  // STOP on every lane in use, including lanes dropped after a NACK
+  void stopBit();
+
+  uint8_t getLaneCount();
+  // Lanes used by the high level methods (bit n = lane n). Default is all lanes.
+  void setLanes(uint8_t lanes);
+  uint8_t getLanes();
+  uint8_t getDeviceID();
+  void setDeviceID(uint8_t deviceid);
+
+protected:
+  uint8_t startTransaction(uint8_t r_w);
+  void readData(uint8_t* buffer, uint8_t count, bool sendStopBit);
+  uint8_t _deviceID;
+  uint8_t _lanes;
+};
+
+// Runtime pins: SDA pins in <sda_pins> (copied), one shared SCL pin
+class SWI2CMulti : public SWI2CMultiCore<SWI2C_PinLanes, SWI2C_PinLine> {
+public:
+  SWI2CMulti(const uint8_t* sda_pins, uint8_t laneCount, uint8_t scl_pin, uint8_t deviceID);
+};
+
+template <class LANES, class SCL_LINE>
+SWI2CMultiCore<LANES, SCL_LINE>::SWI2CMultiCore(const LANES& sda, const SCL_LINE& scl, uint8_t deviceID) :
+  SWI2CBusCore<LANES, SCL_LINE>(sda, scl, false) {
+  _deviceID = deviceID;
+  _lanes = 0xFF;
+}
+
+template <class LANES, class SCL_LINE>
+void SWI2CMultiCore<LANES, SCL_LINE>::begin() {
+  SWI2CBusCore<LANES, SCL_LINE>::begin();
+  this->_sda.setActive(_lanes);
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::checkAckLanes() {
+  uint8_t sample;
+  uint8_t nack = 0;
+  uint8_t active = this->_sda.getActive();
+
+  this->sdaHi();    // Release data lines for ACK from the devices
+  this->sclHi();
+  sample = this->_sda.readAll();
+  this->sclLo();
+  for (uint8_t i = 0; i < this->_sda.getLaneCount(); i++) {
+    if ((active & (1 << i)) && (sample & this->_sda.laneBit(i))) nack |= (1 << i);
+  }
+  if (nack) this->_sda.setActive(active & ~nack);
+  return active & ~nack;
+}
+
+template <class LANES, class SCL_LINE>
+void SWI2CMultiCore<LANES, SCL_LINE>::readLanes(uint8_t* data) {
+  // Sample all lanes once per bit, then sort the bits into bytes after
+  // the clocks, so the time between clocks is the same as for one lane
+  uint8_t samples[8];
+  uint8_t i, b, bit, value;
+
+  for (b = 0; b < 8; b++) {
+    this->sclHi();
+    samples[b] = this->_sda.readAll();
+    this->sclLo();
+  }
+  for (i = 0; i < this->_sda.getLaneCount(); i++) {
+    bit = this->_sda.laneBit(i);
+    value = 0;
+    for (b = 0; b < 8; b++) {
+      value <<= 1;
+      if (samples[b] & bit) value |= 1;
+    }
+    data[i] = value;
+  }
+}
+
+template <class LANES, class SCL_LINE>
+void SWI2CMultiCore<LANES, SCL_LINE>::stopBit() {
+  this->_sda.setActive(_lanes);
+  SWI2CBusCore<LANES, SCL_LINE>::stopBit();
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::startTransaction(uint8_t r_w) {
+  // START and address on every lane in use. Returns the lanes that ACKed.
+  this->_sda.setActive(_lanes);
+  this->startBit();
+  this->writeAddress(_deviceID, r_w);
+  return checkAckLanes();
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::writeToRegister(uint8_t regAddress, uint8_t data, bool sendStopBit) {
+  return writeToRegister(regAddress, &data, 1, sendStopBit);
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::writeToRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // Writes the same <count> bytes to every lane
+  uint8_t active;
+
+  active = startTransaction(0);
+  if (active) {
+    this->writeRegister(regAddress);
+    active = checkAckLanes();
+  }
+  for (uint8_t i = 0; i < count && active; i++) {
+    this->writeByte(buffer[i]);
+    active = checkAckLanes();
+  }
+  if (sendStopBit || !active) stopBit();   // Always end the transaction if every lane NACKed
+  return active;
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::readFromRegister(uint8_t regAddress, uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  uint8_t active;
+
+  active = startTransaction(0);
+  if (active) {
+    this->writeRegister(regAddress);
+    active = checkAckLanes();
+  }
+  if (!active) {stopBit(); return 0;}
+  // Repeated START on the lanes that are still active
+  this->startBit();
+  this->writeAddress(_deviceID, 1);
+  active = checkAckLanes();
+  if (!active) {stopBit(); return 0;}
+  readData(buffer, count, sendStopBit);
+  return active;
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::readFromDevice(uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  uint8_t active;
+
+  active = startTransaction(1);
+  if (!active) {stopBit(); return 0;}
+  readData(buffer, count, sendStopBit);
+  return active;
+}
+
+template <class LANES, class SCL_LINE>
+void SWI2CMultiCore<LANES, SCL_LINE>::readData(uint8_t* buffer, uint8_t count, bool sendStopBit) {
+  // Device is already addressed for reading on the active lanes
+  uint8_t data[SWI2C_MAX_LANES];
+  uint8_t lanes = this->_sda.getLaneCount();
+
+  for (uint8_t i = 0; i < count; i++) {
+    readLanes(data);
+    for (uint8_t lane = 0; lane < lanes; lane++) buffer[lane * count + i] = data[lane];
+    if (i < (count-1)) {
+      this->writeAck();
+    }
+    else { // Last byte needs a NACK
+      this->checkAckBit();
+    }
+  }
+  if (sendStopBit) stopBit();
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::getLaneCount() {
+  return this->_sda.getLaneCount();
+}
+
+template <class LANES, class SCL_LINE>
+void SWI2CMultiCore<LANES, SCL_LINE>::setLanes(uint8_t lanes) {
+  _lanes = lanes;
+  this->_sda.setActive(lanes);
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::getLanes() {
+  return _lanes & ((1 << this->_sda.getLaneCount()) - 1);
+}
+
+template <class LANES, class SCL_LINE>
+uint8_t SWI2CMultiCore<LANES, SCL_LINE>::getDeviceID() {
+  return _deviceID;
+}
+
+template <class LANES, class SCL_LINE>
+void SWI2CMultiCore<LANES, SCL_LINE>::setDeviceID(uint8_t deviceid) {
+  // deviceid is the 7-bit I2C address
+  _deviceID = deviceid;
+}
+
+#endif
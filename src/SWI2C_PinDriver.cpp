@@ -0,0 +1,152 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Open-drain pin driver
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Add SWI2C_PinLanes
+*/
+
+#include "SWI2C_PinDriver.h"
+
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+// Used until begin() resolves the real registers, so an early edge can't write to address 0
+static volatile uint8_t unresolvedRegister;
+#endif
+
+SWI2C_PinLine::SWI2C_PinLine(uint8_t pin) {
+  _pin = pin;
+  _released = 1;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+  _mode = &unresolvedRegister;
+  _input = &unresolvedRegister;
+  _mask = 0;
+#endif
+}
+
+void SWI2C_PinLine::begin() {
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+  SWI2C_pinBegin(_pin);
+#else
+  // Set output latch low. With pinMode(OUTPUT), line goes low
+  //   With pinMode(INPUT), then pull-up resistor pulls line high
+  digitalWrite(_pin, LOW);
+  pinMode(_pin, INPUT);
+#endif
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+  uint8_t port = digitalPinToPort(_pin);
+  if (port != NOT_A_PIN) {
+    _mode = portModeRegister(port);
+    _input = portInputRegister(port);
+    _mask = digitalPinToBitMask(_pin);
+  }
+#endif
+  _released = 1;
+}
+
+SWI2C_PinLanes::SWI2C_PinLanes(const uint8_t* pins, uint8_t count) {
+  if (count > SWI2C_MAX_LANES) count = SWI2C_MAX_LANES;
+  _count = count;
+  for (uint8_t i = 0; i < count; i++) _pins[i] = pins[i];
+  _released = 1;
+  _active = 0;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+  _samePort = false;
+  _mode = &unresolvedRegister;
+  _input = &unresolvedRegister;
+#endif
+}
+
+void SWI2C_PinLanes::begin() {
+  for (uint8_t i = 0; i < _count; i++) {
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+    SWI2C_pinBegin(_pins[i]);
+#else
+    digitalWrite(_pins[i], LOW);
+    pinMode(_pins[i], INPUT);
+#endif
+  }
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+  // Use single port accesses if every lane is on the same port
+  uint8_t port = _count ? digitalPinToPort(_pins[0]) : NOT_A_PIN;
+  _samePort = (port != NOT_A_PIN);
+  for (uint8_t i = 0; i < _count; i++) {
+    if (digitalPinToPort(_pins[i]) != port) _samePort = false;
+    _portBits[i] = digitalPinToBitMask(_pins[i]);
+  }
+  if (_samePort) {
+    _mode = portModeRegister(port);
+    _input = portInputRegister(port);
+  }
+#endif
+  _released = 1;
+  _active = 0;
+  setActive((1 << _count) - 1);
+}
+
+void SWI2C_PinLanes::setActive(uint8_t lanes) {
+  uint8_t bits = 0;
+  uint8_t removed, added;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (lanes & (1 << i)) bits |= laneBit(i);
+  }
+  removed = _active & ~bits;
+  added = bits & ~_active;
+  _active = bits;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+  if (_samePort) {
+    uint8_t oldSREG = SREG;
+    cli();
+    *_mode &= ~removed;
+    if (!_released) *_mode |= added;
+    SREG = oldSREG;
+    return;
+  }
+#endif
+  releaseEach(removed);
+  if (!_released) driveLowEach(added);
+}
+
+uint8_t SWI2C_PinLanes::getActive() {
+  uint8_t lanes = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_active & laneBit(i)) lanes |= (1 << i);
+  }
+  return lanes;
+}
+
+// Lane at a time access, used when the lanes are not on a single port.
+// <bits> has bit n set for lane n.
+void SWI2C_PinLanes::releaseEach(uint8_t bits) {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (!(bits & (1 << i))) continue;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+    SWI2C_pinRelease(_pins[i]);
+#else
+    pinMode(_pins[i], INPUT);
+#endif
+  }
+}
+
+void SWI2C_PinLanes::driveLowEach(uint8_t bits) {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (!(bits & (1 << i))) continue;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+    SWI2C_pinDriveLow(_pins[i]);
+#else
+    pinMode(_pins[i], OUTPUT);
+#endif
+  }
+}
+
+uint8_t SWI2C_PinLanes::readEach() {
+  uint8_t bits = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+    if (SWI2C_pinRead(_pins[i])) bits |= (1 << i);
+#else
+    if (digitalRead(_pins[i])) bits |= (1 << i);
+#endif
+  }
+  return bits;
+}
@@ -0,0 +1,262 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Open-drain pin driver
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Add SWI2C_FixedLine for pins known at compile time
+   10/16/2026 - Andy4495 - Add getMillis() time source
+   10/16/2026 - Andy4495 - Add getMicros() time source for speed calibration
+   10/16/2026 - Andy4495 - Add SWI2C_PinLanes for several SDA lines driven together
+*/
+/* -----------------------------------------------------------------
+   Each I2C line (SDA or SCL) is driven as an open-drain signal:
+     - release():  pin in INPUT (Hi-Z) mode, pull-up resistor pulls line high
+     - driveLow(): pin in OUTPUT mode, output latch is LOW so the line is pulled low
+     - read():     current level of the line
+   getMillis() is the time source used for clock-stretching timeouts, and
+   getMicros() is used to calibrate the bus speed. They are part of the pin
+   driver so that a simulated bus can count and model time.
+
+   The driver used for these operations is selected at compile time with
+   SWI2C_PIN_DRIVER:
+     - SWI2C_PIN_DRIVER_ARDUINO: portable pinMode()/digitalRead() calls
+     - SWI2C_PIN_DRIVER_DIRECT:  the pin's direction/input register and bit mask
+                                 are looked up once in begin(), and each edge
+                                 is a direct register access (AVR only)
+     - SWI2C_PIN_DRIVER_CUSTOM:  user-supplied SWI2C_pin*() functions, for example
+                                 a mock driver when building on a host PC
+
+   If SWI2C_PIN_DRIVER is not defined, DIRECT is used on AVR and ARDUINO
+   is used on all other platforms.
+
+   SWI2C_PinLine takes the pin number at runtime. SWI2C_FixedLine<PIN> takes
+   it as a template parameter. With the DIRECT driver on an ATmega328P/168
+   (Uno, Nano, Pro Mini pin mapping), the port and mask are then constants
+   and each edge compiles to a single sbi/cbi/sbic instruction. Elsewhere
+   SWI2C_FixedLine falls back to SWI2C_PinLine.
+
+   SWI2C_PinLanes drives up to SWI2C_MAX_LANES SDA pins ("lanes") as a
+   single line, for SWI2CMulti. With the DIRECT driver, if all the lanes
+   are on the same port, each edge and each sample is a single port
+   register access for all lanes. Otherwise each lane is accessed in turn.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_PINDRIVER_H
+#define SWI2C_PINDRIVER_H
+
+#include "Arduino.h"
+
+#define SWI2C_PIN_DRIVER_ARDUINO 0
+#define SWI2C_PIN_DRIVER_DIRECT  1
+#define SWI2C_PIN_DRIVER_CUSTOM  2
+
+#ifndef SWI2C_PIN_DRIVER
+#if defined(__AVR__)
+#define SWI2C_PIN_DRIVER SWI2C_PIN_DRIVER_DIRECT
+#else
+#define SWI2C_PIN_DRIVER SWI2C_PIN_DRIVER_ARDUINO
+#endif
+#endif
+
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT && !defined(__AVR__)
+#error "SWI2C_PIN_DRIVER_DIRECT is only supported on AVR. Use SWI2C_PIN_DRIVER_ARDUINO."
+#endif
+
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+// Supplied by the user when building with the custom driver.
+// SWI2C_pinBegin() is called once from begin(); the line should be left released.
+void SWI2C_pinBegin(uint8_t pin);
+void SWI2C_pinRelease(uint8_t pin);
+void SWI2C_pinDriveLow(uint8_t pin);
+uint8_t SWI2C_pinRead(uint8_t pin);
+#endif
+
+class SWI2C_PinLine {
+public:
+  SWI2C_PinLine(uint8_t pin);
+  void begin();
+  uint8_t getPin() {return _pin;}
+  // Last state commanded by release()/driveLow(). Lets callers skip redundant edges.
+  uint8_t isReleased() {return _released;}
+
+  void release() {
+    _released = 1;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+    uint8_t oldSREG = SREG;  // Direction register may be shared with pins used in ISRs
+    cli();
+    *_mode &= ~_mask;
+    SREG = oldSREG;
+#elif SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+    SWI2C_pinRelease(_pin);
+#else
+    pinMode(_pin, INPUT);    // I2C pull-up resistor pulls signal high
+#endif
+  }
+
+  void driveLow() {
+    _released = 0;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+    uint8_t oldSREG = SREG;
+    cli();
+    *_mode |= _mask;         // Output latch set LOW in begin()
+    SREG = oldSREG;
+#elif SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+    SWI2C_pinDriveLow(_pin);
+#else
+    pinMode(_pin, OUTPUT);   // Output latch set LOW in begin()
+#endif
+  }
+
+  uint8_t read() {
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+    return (*_input & _mask) ? HIGH : LOW;
+#elif SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_CUSTOM
+    return SWI2C_pinRead(_pin);
+#else
+    return digitalRead(_pin);
+#endif
+  }
+
+  unsigned long getMillis() {return millis();}
+  unsigned long getMicros() {return micros();}
+
+private:
+  uint8_t _pin;
+  uint8_t _released;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+  volatile uint8_t* _mode;
+  volatile uint8_t* _input;
+  uint8_t _mask;
+#endif
+};
+
+#define SWI2C_MAX_LANES 8
+
+class SWI2C_PinLanes {
+public:
+  // <pins> is copied, so it does not need to remain valid
+  SWI2C_PinLanes(const uint8_t* pins, uint8_t count);
+  void begin();
+  uint8_t getPin(uint8_t lane = 0) {return _pins[lane];}
+  uint8_t getLaneCount() {return _count;}
+  uint8_t isReleased() {return _released;}
+
+  // Release or drive low all active lanes together
+  void release() {
+    _released = 1;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+    if (_samePort) {
+      uint8_t oldSREG = SREG;
+      cli();
+      *_mode &= ~_active;
+      SREG = oldSREG;
+      return;
+    }
+#endif
+    releaseEach(_active);
+  }
+
+  void driveLow() {
+    _released = 0;
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+    if (_samePort) {
+      uint8_t oldSREG = SREG;
+      cli();
+      *_mode |= _active;
+      SREG = oldSREG;
+      return;
+    }
+#endif
+    driveLowEach(_active);
+  }
+
+  // Samples all lanes at once. Test the result with laneBit().
+  uint8_t readAll() {
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+    if (_samePort) return *_input;
+#endif
+    return readEach();
+  }
+  uint8_t laneBit(uint8_t lane) {
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+    if (_samePort) return _portBits[lane];
+#endif
+    return 1 << lane;
+  }
+  // HIGH only if every active lane is high, as if the lanes were wired together
+  uint8_t read() {return ((readAll() & _active) == _active) ? HIGH : LOW;}
+
+  // Lanes (bit n = lane n) that follow release() and driveLow(). Lanes
+  // removed from the set are released; lanes added take the current state.
+  void setActive(uint8_t lanes);
+  uint8_t getActive();
+
+private:
+  void releaseEach(uint8_t bits);
+  void driveLowEach(uint8_t bits);
+  uint8_t readEach();
+
+  uint8_t _pins[SWI2C_MAX_LANES];
+  uint8_t _count;
+  uint8_t _released;
+  uint8_t _active;      // Active lanes, as laneBit() bits
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT
+  bool _samePort;       // All lanes on one port: bits are port register bits
+  volatile uint8_t* _mode;
+  volatile uint8_t* _input;
+  uint8_t _portBits[SWI2C_MAX_LANES];
+#endif
+};
+
+#if SWI2C_PIN_DRIVER == SWI2C_PIN_DRIVER_DIRECT && \
+    (defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || \
+     defined(__AVR_ATmega168__)  || defined(__AVR_ATmega168P__))
+// Standard ATmega328P pin mapping: D0-D7 = PORTD, D8-D13 = PORTB, A0-A5 (14-19) = PORTC
+// The register and mask are compile-time constants, so the branches below fold away.
+template <uint8_t PIN>
+class SWI2C_FixedLine {
+public:
+  void begin() {
+    typedef char pin_must_be_0_to_19[(PIN < 20) ? 1 : -1];  // A6/A7 are analog-only
+    (void) sizeof(pin_must_be_0_to_19);
+    digitalWrite(PIN, LOW);
+    pinMode(PIN, INPUT);
+  }
+  uint8_t getPin() {return PIN;}
+  unsigned long getMillis() {return millis();}
+  unsigned long getMicros() {return micros();}
+  // Direction register bit is the line state, so no RAM is needed to track it
+  uint8_t isReleased() {
+    if (PIN < 8)       return !(DDRD & MASK);
+    else if (PIN < 14) return !(DDRB & MASK);
+    else               return !(DDRC & MASK);
+  }
+  void release() {
+    if (PIN < 8)       DDRD &= ~MASK;
+    else if (PIN < 14) DDRB &= ~MASK;
+    else               DDRC &= ~MASK;
+  }
+  void driveLow() {
+    if (PIN < 8)       DDRD |= MASK;
+    else if (PIN < 14) DDRB |= MASK;
+    else               DDRC |= MASK;
+  }
+  uint8_t read() {
+    if (PIN < 8)       return (PIND & MASK) ? HIGH : LOW;
+    else if (PIN < 14) return (PINB & MASK) ? HIGH : LOW;
+    else               return (PINC & MASK) ? HIGH : LOW;
+  }
+private:
+  enum {MASK = (PIN < 8) ? (1 << PIN) : ((PIN < 14) ? (1 << (PIN - 8)) : (1 << ((PIN - 14) & 7)))};
+};
+#else
+template <uint8_t PIN>
+class SWI2C_FixedLine : public SWI2C_PinLine {
+public:
+  SWI2C_FixedLine() : SWI2C_PinLine(PIN) {}
+};
+#endif
+
+#endif
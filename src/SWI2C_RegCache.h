@@ -0,0 +1,185 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Shadow register cache
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   SWI2CRegCache keeps shadow copies of a block of SIZE device
+   registers, starting at register <firstRegister>. It is meant for
+   configuration registers that only the controller changes:
+
+     SWI2C myDevice(SDA_PIN, SCL_PIN, 0x68);
+     SWI2CRegCache<SWI2C, 0x20> config(myDevice, 0x00);  // Registers 0x00-0x1F
+     config.setCacheable(0x00, 0x20);
+     config.updateBits(0x1A, 0x07, 0x03);   // No bus traffic once 0x1A is cached
+     config.updateBits(0x1B, 0x18, 0x08);
+     config.flush();                        // One burst writes 0x1A and 0x1B
+
+   For registers marked cacheable:
+     - read() returns the cached value. Only the first read goes to the device.
+     - write() and updateBits() change the cached value and mark it dirty.
+       Nothing is sent until flush().
+     - flush() writes each run of consecutive dirty registers with one
+       auto-increment writeToRegister(reg, buffer, count), so the device
+       must support auto-increment register writes.
+   All other registers (not cacheable, or outside the block) are read
+   and written on the device directly.
+
+   DEVICE is any SWI2C device class (SWI2C, SWI2CT, SWI2CDevice, ...).
+   The cache uses SIZE bytes plus 3 bits per register of RAM.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_REGCACHE_H
+#define SWI2C_REGCACHE_H
+
+#include "Arduino.h"
+
+template <class DEVICE, uint8_t SIZE>
+class SWI2CRegCache {
+public:
+  SWI2CRegCache(DEVICE& device, uint8_t firstRegister);
+
+  // Mark <count> registers starting at <regAddress> as cacheable (or not).
+  // Making a dirty register uncacheable discards the unwritten value.
+  void setCacheable(uint8_t regAddress, uint8_t count = 1, bool cacheable = true);
+  bool isCacheable(uint8_t regAddress);
+  bool isDirty(uint8_t regAddress);
+
+  // Same return codes as the SWI2C high level methods: 1 if successful, 0 if a NACK was received
+  int read(uint8_t regAddress, uint8_t &data);
+  int write(uint8_t regAddress, uint8_t data);
+  // Changes only the bits in <mask> to the matching bits of <value>.
+  // A register that does not change is not written or marked dirty.
+  int updateBits(uint8_t regAddress, uint8_t mask, uint8_t value);
+
+  // Writes all dirty registers, merging consecutive registers into one burst.
+  // Registers in a burst that fails stay dirty.
+  int flush();
+  // Forget all cached values (for example after resetting the device). Dirty values are lost.
+  void invalidate();
+
+private:
+  enum {FLAG_BYTES = (SIZE + 7) / 8};
+  bool inCache(uint8_t regAddress);
+  static bool getBit(const uint8_t* bits, uint8_t i) {return bits[i >> 3] & (1 << (i & 7));}
+  static void setBit(uint8_t* bits, uint8_t i, bool value);
+
+  DEVICE* _device;
+  uint8_t _first;
+  uint8_t _values[SIZE];
+  uint8_t _cacheable[FLAG_BYTES];
+  uint8_t _valid[FLAG_BYTES];
+  uint8_t _dirty[FLAG_BYTES];
+};
+
+template <class DEVICE, uint8_t SIZE>
+SWI2CRegCache<DEVICE, SIZE>::SWI2CRegCache(DEVICE& device, uint8_t firstRegister) {
+  _device = &device;
+  _first = firstRegister;
+  memset(_values, 0, sizeof(_values));
+  memset(_cacheable, 0, sizeof(_cacheable));
+  memset(_valid, 0, sizeof(_valid));
+  memset(_dirty, 0, sizeof(_dirty));
+}
+
+template <class DEVICE, uint8_t SIZE>
+void SWI2CRegCache<DEVICE, SIZE>::setBit(uint8_t* bits, uint8_t i, bool value) {
+  if (value) bits[i >> 3] |= (1 << (i & 7));
+  else bits[i >> 3] &= ~(1 << (i & 7));
+}
+
+template <class DEVICE, uint8_t SIZE>
+bool SWI2CRegCache<DEVICE, SIZE>::inCache(uint8_t regAddress) {
+  return (uint8_t)(regAddress - _first) < SIZE && getBit(_cacheable, regAddress - _first);
+}
+
+template <class DEVICE, uint8_t SIZE>
+void SWI2CRegCache<DEVICE, SIZE>::setCacheable(uint8_t regAddress, uint8_t count, bool cacheable) {
+  for (uint8_t n = 0; n < count; n++) {
+    uint8_t i = regAddress + n - _first;
+    if (i >= SIZE) continue;
+    setBit(_cacheable, i, cacheable);
+    if (!cacheable) {
+      setBit(_valid, i, false);
+      setBit(_dirty, i, false);
+    }
+  }
+}
+
+template <class DEVICE, uint8_t SIZE>
+bool SWI2CRegCache<DEVICE, SIZE>::isCacheable(uint8_t regAddress) {
+  return inCache(regAddress);
+}
+
+template <class DEVICE, uint8_t SIZE>
+bool SWI2CRegCache<DEVICE, SIZE>::isDirty(uint8_t regAddress) {
+  return inCache(regAddress) && getBit(_dirty, regAddress - _first);
+}
+
+template <class DEVICE, uint8_t SIZE>
+int SWI2CRegCache<DEVICE, SIZE>::read(uint8_t regAddress, uint8_t &data) {
+  uint8_t i = regAddress - _first;
+
+  if (!inCache(regAddress)) return _device->readFromRegister(regAddress, data);
+  if (!getBit(_valid, i)) {
+    if (_device->readFromRegister(regAddress, _values[i]) == 0) return 0;
+    setBit(_valid, i, true);
+  }
+  data = _values[i];
+  return 1;
+}
+
+template <class DEVICE, uint8_t SIZE>
+int SWI2CRegCache<DEVICE, SIZE>::write(uint8_t regAddress, uint8_t data) {
+  uint8_t i = regAddress - _first;
+
+  if (!inCache(regAddress)) return _device->writeToRegister(regAddress, data);
+  _values[i] = data;
+  setBit(_valid, i, true);
+  setBit(_dirty, i, true);
+  return 1;
+}
+
+template <class DEVICE, uint8_t SIZE>
+int SWI2CRegCache<DEVICE, SIZE>::updateBits(uint8_t regAddress, uint8_t mask, uint8_t value) {
+  uint8_t data;
+  uint8_t updated;
+
+  if (read(regAddress, data) == 0) return 0;
+  updated = (data & ~mask) | (value & mask);
+  if (updated == data) return 1;   // Already set: no bus traffic
+  return write(regAddress, updated);
+}
+
+template <class DEVICE, uint8_t SIZE>
+int SWI2CRegCache<DEVICE, SIZE>::flush() {
+  int result = 1;
+  uint8_t start;
+  uint8_t i = 0;
+
+  while (i < SIZE) {
+    if (!getBit(_dirty, i)) {
+      i++;
+      continue;
+    }
+    // Find the run of consecutive dirty registers starting at <start>
+    start = i;
+    while (i < SIZE && getBit(_dirty, i)) i++;
+    if (_device->writeToRegister(_first + start, &_values[start], i - start)) {
+      for (uint8_t j = start; j < i; j++) setBit(_dirty, j, false);
+    }
+    else result = 0;
+  }
+  return result;
+}
+
+template <class DEVICE, uint8_t SIZE>
+void SWI2CRegCache<DEVICE, SIZE>::invalidate() {
+  memset(_valid, 0, sizeof(_valid));
+  memset(_dirty, 0, sizeof(_dirty));
+}
+
+#endif
@@ -0,0 +1,85 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Typed register descriptors
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   A register descriptor is a type that describes one device register:
+   address, width in bits (8, 16, 24, or 32), byte order, signedness,
+   and access mode. A driver declares its register map once:
+
+     typedef SWI2C_Reg<0x3B, 16, SWI2C_MSB_FIRST, true, SWI2C_RO> ACCEL_XOUT;
+     typedef SWI2C_Reg<0x6B, 8> PWR_MGMT_1;
+
+   and then reads and writes registers with values of the right type,
+   without any byte shifting or swapping:
+
+     int16_t ax;
+     mpu.read<ACCEL_XOUT>(ax);
+     mpu.write<PWR_MGMT_1>(0x01);
+     mpu.update<PWR_MGMT_1>(0x07, 0x03);   // Read-modify-write of bits 0-2
+
+   Everything about the register is known at compile time. Each byte is
+   shifted into its place in the value, in the register's byte order, as
+   it is received, so there is no swap after the transfer. Using an unsupported width, or reading a
+   write-only register (or writing a read-only register), is a compile
+   error.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_REGISTER_H
+#define SWI2C_REGISTER_H
+
+#include "Arduino.h"
+
+// Byte order on the bus
+#define SWI2C_LSB_FIRST   0
+#define SWI2C_MSB_FIRST   1
+
+// Access modes
+#define SWI2C_RO          1
+#define SWI2C_WO          2
+#define SWI2C_RW          3
+
+// Value type for a register of <BYTES> bytes. Not defined for other sizes,
+// so an unsupported width does not compile.
+template <uint8_t BYTES, bool SIGNED> struct SWI2C_RegType;
+template <> struct SWI2C_RegType<1, false> {typedef uint8_t type;};
+template <> struct SWI2C_RegType<1, true>  {typedef int8_t type;};
+template <> struct SWI2C_RegType<2, false> {typedef uint16_t type;};
+template <> struct SWI2C_RegType<2, true>  {typedef int16_t type;};
+template <> struct SWI2C_RegType<3, false> {typedef uint32_t type;};
+template <> struct SWI2C_RegType<3, true>  {typedef int32_t type;};
+template <> struct SWI2C_RegType<4, false> {typedef uint32_t type;};
+template <> struct SWI2C_RegType<4, true>  {typedef int32_t type;};
+
+// Compile-time check: only SWI2C_Check<true> is defined
+template <bool OK> struct SWI2C_Check;
+template <> struct SWI2C_Check<true> {};
+
+template <uint8_t ADDRESS, uint8_t WIDTH, uint8_t ORDER = SWI2C_MSB_FIRST, bool SIGNED = false, uint8_t ACCESS = SWI2C_RW>
+struct SWI2C_Reg {
+  enum {
+    address = ADDRESS,
+    bytes = WIDTH / 8,
+    order = ORDER,
+    access = ACCESS,
+    widthCheck = sizeof(SWI2C_Check<WIDTH % 8 == 0>)
+  };
+  typedef typename SWI2C_RegType<WIDTH / 8, SIGNED>::type type;       // Value type, e.g. int16_t
+  typedef typename SWI2C_RegType<WIDTH / 8, false>::type raw_type;    // Bits as transferred
+
+  // Sign-extends 24-bit values; the other widths fill their type exactly
+  static type fromRaw(raw_type raw) {
+    if (SIGNED && WIDTH == 24 && (raw & 0x800000UL)) raw |= 0xFF000000UL;
+    return (type)raw;
+  }
+  static raw_type toRaw(type value) {
+    if (WIDTH == 24) return (raw_type)value & 0xFFFFFFUL;
+    return (raw_type)value;
+  }
+};
+
+#endif
@@ -0,0 +1,52 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Ring buffer for streaming reads
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Treat a size of 0 as 1
+*/
+
+#include "SWI2C_Ring.h"
+
+SWI2CRing::SWI2CRing(uint8_t* buffer, uint16_t size) {
+  _buffer = buffer;
+  _size = size ? size : 1;   // space() would underflow with no slot to keep empty
+  _head = 0;
+  _tail = 0;
+}
+
+uint16_t SWI2CRing::available() {
+  return (_head >= _tail) ? _head - _tail : _size - _tail + _head;
+}
+
+uint16_t SWI2CRing::space() {
+  return _size - 1 - available();
+}
+
+int SWI2CRing::read() {
+  uint8_t data;
+  if (_head == _tail) return -1;
+  data = _buffer[_tail];
+  if (++_tail == _size) _tail = 0;
+  return data;
+}
+
+int SWI2CRing::peek() {
+  if (_head == _tail) return -1;
+  return _buffer[_tail];
+}
+
+uint16_t SWI2CRing::read(uint8_t* data, uint16_t count) {
+  uint16_t n = 0;
+  while (n < count && _head != _tail) {
+    data[n++] = _buffer[_tail];
+    if (++_tail == _size) _tail = 0;
+  }
+  return n;
+}
+
+void SWI2CRing::clear() {
+  _head = 0;
+  _tail = 0;
+}
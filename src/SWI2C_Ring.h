@@ -0,0 +1,54 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Ring buffer for streaming reads
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Treat a size of 0 as 1
+*/
+/* -----------------------------------------------------------------
+   Byte ring buffer over caller-supplied storage, used by
+   streamFromRegister() and drainFIFO(). Bytes read from the device are
+   stored directly in the ring, without an intermediate buffer.
+
+   A ring of <size> bytes holds up to <size> - 1 bytes, so the minimum
+   useful size is 2. A size of 0 is treated as 1: a ring that is always
+   full, and never touches <buffer>. The stream
+   methods only add bytes and the sketch only removes them, so the
+   sketch can process bytes between reads without copying them out.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_RING_H
+#define SWI2C_RING_H
+
+#include "Arduino.h"
+
+class SWI2CRing {
+public:
+  SWI2CRing(uint8_t* buffer, uint16_t size);
+
+  uint16_t available();     // Bytes stored
+  uint16_t space();         // Bytes that can still be added
+  int read();               // Removes and returns the oldest byte, or -1 if empty
+  int peek();               // Returns the oldest byte without removing it, or -1 if empty
+  uint16_t read(uint8_t* data, uint16_t count);   // Removes up to <count> bytes, returns the number removed
+  void clear();
+
+  // Adds a byte. Returns false, and does not add it, if the ring is full.
+  bool write(uint8_t data) {
+    uint16_t next = (_head + 1 == _size) ? 0 : _head + 1;
+    if (next == _tail) return false;
+    _buffer[_head] = data;
+    _head = next;
+    return true;
+  }
+
+private:
+  uint8_t* _buffer;
+  uint16_t _size;
+  uint16_t _head;     // Next byte written
+  uint16_t _tail;     // Next byte read
+};
+
+#endif
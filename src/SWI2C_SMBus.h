@@ -0,0 +1,291 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - SMBus protocol layer
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Own the bus for each transaction (SWI2C_BUS_LOCK)
+   10/16/2026 - Andy4495 - Fail with SWI2C_MSG_BUS_STUCK if SDA is stuck low
+   10/16/2026 - Andy4495 - Continue a transaction left open by a high level method
+   10/16/2026 - Andy4495 - Report only this transaction's stretch timeout
+*/
+/* -----------------------------------------------------------------
+   SWI2CSMBus provides the SMBus transactions, with optional Packet
+   Error Checking (PEC), for a device on an SWI2C bus:
+
+     SWI2C battery(SDA_PIN, SCL_PIN, 0x0B);
+     SWI2CSMBus<SWI2C> smbus(battery, true);   // PEC enabled
+     uint16_t millivolts;
+     smbus.readWordData(0x09, millivolts);     // SBS Voltage()
+
+   The PEC (CRC-8, polynomial x^8 + x^2 + x + 1) covers every address,
+   command, and data byte of the transaction. It is updated with a table
+   lookup as each byte is sent or received, so checking it does not take
+   another pass over the data. A PEC mismatch returns 0, and
+   getLastError() returns SWI2C_MSG_PEC_ERROR. Words are sent and
+   received LSB first, as defined by SMBus.
+
+   DEVICE is any SWI2C device class (SWI2C, SWI2CT, SWI2CDevice, ...).
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_SMBUS_H
+#define SWI2C_SMBUS_H
+
+#include "Arduino.h"
+#include "SWI2C_Core.h"
+
+#define SWI2C_SMBUS_BLOCK_MAX  32   // Largest block in SMBus 2.0 (SMBus 3.0 allows 255)
+
+// CRC-8 table for the PEC, in flash on AVR
+extern const uint8_t SWI2C_crc8Table[256] PROGMEM;
+
+inline uint8_t SWI2C_crc8(uint8_t crc, uint8_t data) {
+  return SWI2C_READ_PROGMEM(&SWI2C_crc8Table[crc ^ data]);
+}
+
+template <class DEVICE>
+class SWI2CSMBus {
+public:
+  SWI2CSMBus(DEVICE& device, bool pec = false);
+  void setPEC(bool pec) {_usePec = pec;}
+  bool getPEC() {return _usePec;}
+
+  // Same return codes as the SWI2C high level methods: 1 if successful,
+  // 0 if not. getLastError() has the reason.
+  int quickCommand(uint8_t r_w);     // No PEC
+  int sendByte(uint8_t data);
+  int receiveByte(uint8_t& data);
+  int writeByteData(uint8_t command, uint8_t data);
+  int readByteData(uint8_t command, uint8_t& data);
+  int writeWordData(uint8_t command, uint16_t data);
+  int readWordData(uint8_t command, uint16_t& data);
+  int processCall(uint8_t command, uint16_t data, uint16_t& result);
+  int blockWrite(uint8_t command, const uint8_t* buffer, uint8_t count);
+  // Reads a block of up to <maxCount> bytes and sets <count> to its length.
+  // A longer block is not read, and returns SWI2C_MSG_INVALID.
+  int blockRead(uint8_t command, uint8_t* buffer, uint8_t& count, uint8_t maxCount = SWI2C_SMBUS_BLOCK_MAX);
+
+  // SWI2C_MSG_OK, SWI2C_MSG_ADDRESS_NACK, SWI2C_MSG_DATA_NACK, SWI2C_MSG_STRETCH_TIMEOUT,
+  // SWI2C_MSG_PEC_ERROR, SWI2C_MSG_INVALID, or SWI2C_MSG_BUS_STUCK
+  uint8_t getLastError() {return _lastError;}
+
+private:
+  bool open();
+  bool start(uint8_t r_w);
+  bool send(uint8_t data);
+  uint8_t receive(bool ack);
+  int end(uint8_t result);
+  int endWrite();
+  int endRead();
+
+  DEVICE* _device;
+  bool _usePec;
+  uint8_t _pec;       // CRC of the bytes so far in this transaction
+  uint8_t _lastError;
+};
+
+template <class DEVICE>
+SWI2CSMBus<DEVICE>::SWI2CSMBus(DEVICE& device, bool pec) {
+  _device = &device;
+  _usePec = pec;
+  _pec = 0;
+  _lastError = SWI2C_MSG_OK;
+}
+
+template <class DEVICE>
+bool SWI2CSMBus<DEVICE>::open() {
+  // Every transaction ends with end(), which frees the bus. Returns false
+  // if the bus is stuck.
+#if SWI2C_BUS_LOCK
+  _device->getBus().beginOwned();   // Continues a transaction left open by a high level method
+#endif
+  _pec = 0;
+  return _device->getBus().beginAttempts();
+}
+
+template <class DEVICE>
+bool SWI2CSMBus<DEVICE>::start(uint8_t r_w) {
+  // START (or repeated START) and address. Returns true if ACKed.
+  uint8_t id = _device->getDeviceID();
+  _device->startBit();
+  _device->writeAddress(r_w);
+  _pec = SWI2C_crc8(_pec, (id << 1) | r_w);
+  return _device->checkAckBit() == 0;
+}
+
+template <class DEVICE>
+bool SWI2CSMBus<DEVICE>::send(uint8_t data) {
+  // Returns true if ACKed
+  _device->writeByte(data);
+  _pec = SWI2C_crc8(_pec, data);
+  return _device->checkAckBit() == 0;
+}
+
+template <class DEVICE>
+uint8_t SWI2CSMBus<DEVICE>::receive(bool ack) {
+  // ACK to ask for another byte, NACK after the last
+  uint8_t data = _device->read1Byte();
+  _pec = SWI2C_crc8(_pec, data);
+  if (ack) _device->writeAck();
+  else _device->checkAckBit();
+  return data;
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::end(uint8_t result) {
+  // Ends the transaction, successful or not, with <result>. Nothing was
+  // sent on a stuck bus, so there is no STOP. A stretch timeout during
+  // this transaction replaces <result>. The checkStretchTimeout() flag is
+  // left for the caller.
+  if (result == SWI2C_MSG_OK) {
+    if (!_device->getBus().finishAttempt(true)) result = _device->getBus().getLastError();
+  }
+  else if (result != SWI2C_MSG_BUS_STUCK) {
+    _device->getBus().attemptFailed(result);   // STOP, or recover() after a timeout
+    result = _device->getBus().getLastError();
+  }
+#if SWI2C_BUS_LOCK
+  _device->getBus().endOwned(false);
+#endif
+  _lastError = result;
+  return result == SWI2C_MSG_OK;
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::endWrite() {
+  // Sends the PEC byte if enabled, then the STOP
+  if (_usePec && !send(_pec)) return end(SWI2C_MSG_DATA_NACK);
+  return end(SWI2C_MSG_OK);
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::endRead() {
+  // Reads the PEC byte if enabled: the CRC including it is 0 if it matches
+  if (_usePec) {
+    receive(false);
+    if (_pec != 0) return end(SWI2C_MSG_PEC_ERROR);
+  }
+  return end(SWI2C_MSG_OK);
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::quickCommand(uint8_t r_w) {
+  // The R/W bit is the data
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(r_w)) return end(SWI2C_MSG_ADDRESS_NACK);
+  return end(SWI2C_MSG_OK);
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::sendByte(uint8_t data) {
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(0)) return end(SWI2C_MSG_ADDRESS_NACK);
+  if (!send(data)) return end(SWI2C_MSG_DATA_NACK);
+  return endWrite();
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::receiveByte(uint8_t& data) {
+  uint8_t value;
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(1)) return end(SWI2C_MSG_ADDRESS_NACK);
+  value = receive(_usePec);
+  if (!endRead()) return 0;
+  data = value;
+  return 1;
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::writeByteData(uint8_t command, uint8_t data) {
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(0)) return end(SWI2C_MSG_ADDRESS_NACK);
+  if (!send(command) || !send(data)) return end(SWI2C_MSG_DATA_NACK);
+  return endWrite();
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::readByteData(uint8_t command, uint8_t& data) {
+  uint8_t value;
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(0)) return end(SWI2C_MSG_ADDRESS_NACK);
+  if (!send(command)) return end(SWI2C_MSG_DATA_NACK);
+  if (!start(1)) return end(SWI2C_MSG_ADDRESS_NACK);
+  value = receive(_usePec);
+  if (!endRead()) return 0;
+  data = value;
+  return 1;
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::writeWordData(uint8_t command, uint16_t data) {
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(0)) return end(SWI2C_MSG_ADDRESS_NACK);
+  if (!send(command) || !send(data & 0xFF) || !send(data >> 8)) return end(SWI2C_MSG_DATA_NACK);
+  return endWrite();
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::readWordData(uint8_t command, uint16_t& data) {
+  uint16_t value;
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(0)) return end(SWI2C_MSG_ADDRESS_NACK);
+  if (!send(command)) return end(SWI2C_MSG_DATA_NACK);
+  if (!start(1)) return end(SWI2C_MSG_ADDRESS_NACK);
+  value = receive(true);
+  value |= (uint16_t)receive(_usePec) << 8;
+  if (!endRead()) return 0;
+  data = value;
+  return 1;
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::processCall(uint8_t command, uint16_t data, uint16_t& result) {
+  // Writes a word and reads a word in one transaction
+  uint16_t value;
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(0)) return end(SWI2C_MSG_ADDRESS_NACK);
+  if (!send(command) || !send(data & 0xFF) || !send(data >> 8)) return end(SWI2C_MSG_DATA_NACK);
+  if (!start(1)) return end(SWI2C_MSG_ADDRESS_NACK);
+  value = receive(true);
+  value |= (uint16_t)receive(_usePec) << 8;
+  if (!endRead()) return 0;
+  result = value;
+  return 1;
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::blockWrite(uint8_t command, const uint8_t* buffer, uint8_t count) {
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(0)) return end(SWI2C_MSG_ADDRESS_NACK);
+  if (!send(command) || !send(count)) return end(SWI2C_MSG_DATA_NACK);
+  for (uint8_t i = 0; i < count; i++) {
+    if (!send(buffer[i])) return end(SWI2C_MSG_DATA_NACK);
+  }
+  return endWrite();
+}
+
+template <class DEVICE>
+int SWI2CSMBus<DEVICE>::blockRead(uint8_t command, uint8_t* buffer, uint8_t& count, uint8_t maxCount) {
+  uint8_t length;
+  if (!open()) return end(SWI2C_MSG_BUS_STUCK);
+  if (!start(0)) return end(SWI2C_MSG_ADDRESS_NACK);
+  if (!send(command)) return end(SWI2C_MSG_DATA_NACK);
+  if (!start(1)) return end(SWI2C_MSG_ADDRESS_NACK);
+  // The ACK after the length byte depends on the length, so it is not read with receive()
+  length = _device->read1Byte();
+  _pec = SWI2C_crc8(_pec, length);
+  if (length > maxCount) {
+    _device->checkAckBit();   // NACK: do not read the block
+    return end(SWI2C_MSG_INVALID);
+  }
+  if (length > 0 || _usePec) _device->writeAck();
+  else _device->checkAckBit();
+  for (uint8_t i = 0; i < length; i++) {
+    buffer[i] = receive(i < length - 1 || _usePec);
+  }
+  count = length;
+  return endRead();
+}
+
+#endif
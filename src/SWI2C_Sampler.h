@@ -0,0 +1,174 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Timestamped sample acquisition
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Treat a size of 0 as 1
+*/
+/* -----------------------------------------------------------------
+   SWI2CSampler reads a block of BYTES registers (for example, the
+   accelerometer and gyro registers of an MPU6050) and stores each read
+   as a record with the time it was taken, for sensor fusion filters
+   that need the actual sample times:
+
+     SWI2CDevice imu(bus, 0x68);
+     SWI2C_Sample<14> samples[8];
+     SWI2CSampler<SWI2CDevice, 14> sampler(imu, 0x3B, samples, 8);
+     ...
+     sampler.sample();                  // On data ready, or on a timer
+     SWI2C_Sample<14> s;
+     while (sampler.take(s)) filter.update(s.timestamp, s.data);
+
+   The timestamp is getMicros() at the repeated START of the read, just
+   before the device address is sent to read the data, and the duration
+   is the time from then until the STOP. The records are kept in the
+   caller's array, oldest first. When it is full, the oldest record is
+   overwritten, so the newest data is never lost.
+
+   The sampler also tracks the interval between the timestamps of
+   consecutive successful samples, and the jitter: the change in
+   interval from one sample to the next. A read that is delayed (for
+   example, by a device elsewhere on the bus that stretches the clock)
+   shows up as a jump in both. A failed read restarts the tracking.
+
+   DEVICE is any SWI2C device class (SWI2C, SWI2CT, SWI2CDevice, ...).
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_SAMPLER_H
+#define SWI2C_SAMPLER_H
+
+#include "Arduino.h"
+
+template <uint8_t BYTES>
+struct SWI2C_Sample {
+  unsigned long timestamp;    // us, at the repeated START of the read
+  unsigned long duration;     // us from the timestamp until the STOP
+  uint8_t data[BYTES];
+};
+
+struct SWI2C_SampleStats {
+  uint32_t samples;           // Successful reads
+  uint32_t failures;          // Reads that returned 0
+  uint32_t overwritten;       // Records overwritten before they were taken
+  uint32_t intervals;         // Intervals measured (consecutive successful samples)
+  unsigned long minInterval;  // us between consecutive timestamps
+  unsigned long maxInterval;
+  unsigned long totalInterval;    // For the mean (totalInterval / intervals)
+  uint32_t jitters;           // Jitter values measured (one less than intervals)
+  unsigned long minJitter;    // us change in interval from one sample to the next
+  unsigned long maxJitter;
+  unsigned long totalJitter;      // For the mean (totalJitter / jitters)
+  unsigned long maxDuration;
+};
+
+template <class DEVICE, uint8_t BYTES>
+class SWI2CSampler {
+public:
+  // <records> is an array of <size> records. A size of 0 is treated as 1.
+  SWI2CSampler(DEVICE& device, uint8_t regAddress, SWI2C_Sample<BYTES>* records, uint8_t size);
+
+  // Reads BYTES registers from <regAddress> into a new record. Same return
+  // codes as the SWI2C high level methods. A failed read adds no record.
+  int sample();
+  // Records not yet taken
+  uint8_t available() {return _count;}
+  // Copies the oldest record to <record> and removes it. False if there is none.
+  bool take(SWI2C_Sample<BYTES>& record);
+  // Newest record, whether or not it has been taken (undefined before the first sample)
+  const SWI2C_Sample<BYTES>& latest();
+  void clear() {_count = 0;}
+
+  const SWI2C_SampleStats& getStats() {return _stats;}
+  void resetStats();
+
+private:
+  DEVICE* _device;
+  uint8_t _reg;
+  SWI2C_Sample<BYTES>* _records;
+  uint8_t _size;
+  uint8_t _next;              // Record written by the next sample()
+  uint8_t _count;
+  uint8_t _run;               // Consecutive successful samples, up to 2
+  unsigned long _lastTimestamp;
+  unsigned long _lastInterval;
+  SWI2C_SampleStats _stats;
+};
+
+template <class DEVICE, uint8_t BYTES>
+SWI2CSampler<DEVICE, BYTES>::SWI2CSampler(DEVICE& device, uint8_t regAddress, SWI2C_Sample<BYTES>* records, uint8_t size) {
+  _device = &device;
+  _reg = regAddress;
+  _records = records;
+  _size = size ? size : 1;   // sample() and take() need at least one record
+  _next = 0;
+  _count = 0;
+  resetStats();
+}
+
+template <class DEVICE, uint8_t BYTES>
+int SWI2CSampler<DEVICE, BYTES>::sample() {
+  uint8_t data[BYTES];
+  unsigned long timestamp, duration, interval, jitter;
+
+  // Read into a local buffer, so that a failed read does not change the oldest record
+  if (_device->readFromRegister(_reg, data, BYTES, timestamp, duration) == 0) {
+    _stats.failures++;
+    _run = 0;
+    return 0;
+  }
+
+  SWI2C_Sample<BYTES>& record = _records[_next];
+  record.timestamp = timestamp;
+  record.duration = duration;
+  memcpy(record.data, data, BYTES);
+  _next = (_next + 1 == _size) ? 0 : _next + 1;
+  if (_count < _size) _count++;
+  else _stats.overwritten++;
+
+  _stats.samples++;
+  if (duration > _stats.maxDuration) _stats.maxDuration = duration;
+  if (_run > 0) {
+    interval = timestamp - _lastTimestamp;
+    _stats.intervals++;
+    _stats.totalInterval += interval;
+    if (interval < _stats.minInterval) _stats.minInterval = interval;
+    if (interval > _stats.maxInterval) _stats.maxInterval = interval;
+    if (_run > 1) {
+      jitter = (interval > _lastInterval) ? interval - _lastInterval : _lastInterval - interval;
+      _stats.jitters++;
+      _stats.totalJitter += jitter;
+      if (jitter < _stats.minJitter) _stats.minJitter = jitter;
+      if (jitter > _stats.maxJitter) _stats.maxJitter = jitter;
+    }
+    _lastInterval = interval;
+  }
+  if (_run < 2) _run++;
+  _lastTimestamp = timestamp;
+  return 1;
+}
+
+template <class DEVICE, uint8_t BYTES>
+bool SWI2CSampler<DEVICE, BYTES>::take(SWI2C_Sample<BYTES>& record) {
+  if (_count == 0) return false;
+  // The oldest record is <_count> records before the next one to be written
+  record = _records[(_next + _size - _count) % _size];
+  _count--;
+  return true;
+}
+
+template <class DEVICE, uint8_t BYTES>
+const SWI2C_Sample<BYTES>& SWI2CSampler<DEVICE, BYTES>::latest() {
+  return _records[_next ? _next - 1 : _size - 1];
+}
+
+template <class DEVICE, uint8_t BYTES>
+void SWI2CSampler<DEVICE, BYTES>::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+  _stats.minInterval = ~0UL;
+  _stats.minJitter = ~0UL;
+  _run = 0;
+}
+
+#endif
@@ -0,0 +1,273 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Periodic register polling scheduler
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Clarify the merge gap
+   10/16/2026 - Andy4495 - Reject a period of 0
+*/
+/* -----------------------------------------------------------------
+   SWI2CScheduler reads device registers at fixed periods, replacing
+   separate millis() polling loops for each device. Each job reads
+   <count> registers from a device into a buffer every <period> us:
+
+     SWI2CBus bus(SDA_PIN, SCL_PIN);
+     SWI2CDevice imu(bus, 0x68);
+     SWI2CScheduler<SWI2CDevice, 4> scheduler;
+     uint8_t accel[6], gyro[6];
+     scheduler.addJob(imu, 0x3B, accel, 6, 1000);    // 1 kHz
+     scheduler.addJob(imu, 0x43, gyro, 6, 1000);
+     ...
+     void loop() {
+       scheduler.run();
+       if (scheduler.isUpdated(0)) ...              // New data in accel[]
+     }
+
+   Each call to run() reads every job that is due once, earliest deadline
+   (end of the current period) first. Due jobs on the same device whose
+   registers are next to each other, or have at most getMergeGap()
+   registers between them that no job needs (for example, 0x3B-0x40 and
+   0x43-0x48 with the default gap of 2), are read with one
+   auto-increment burst of up to BURST bytes, so jobs that are merged
+   must be on a device that supports auto-increment register reads (see
+   addJob()).
+
+   For each job the scheduler counts runs, failed reads, and overruns
+   (whole periods missed because run() was not called in time), and
+   measures jitter as the lateness of each read: the time from when the
+   job became due until its read started.
+
+   DEVICE is any SWI2C device class (SWI2C, SWI2CT, SWI2CDevice, ...).
+   All jobs should be on the same bus, whose getMicros() is the time
+   source. JOBS is the maximum number of jobs.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_SCHEDULER_H
+#define SWI2C_SCHEDULER_H
+
+#include "Arduino.h"
+
+#define SWI2C_SCHED_FULL   0xFF    // addJob() return value when all JOBS are in use, or the period is 0
+
+struct SWI2C_JobStats {
+  uint32_t runs;              // Reads started (including merged reads)
+  uint32_t failures;          // Reads that returned 0
+  uint32_t overruns;          // Periods skipped because the job was read too late
+  unsigned long lastLate;     // us from due time to the start of the last read
+  unsigned long maxLate;      // Largest lastLate
+  unsigned long totalLate;    // Sum of lastLate, for the mean jitter (totalLate / runs)
+};
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST = 32>
+class SWI2CScheduler {
+public:
+  SWI2CScheduler();
+
+  // Read <count> registers starting at <regAddress> into <buffer> every
+  // <period> us, the first time <phase> us from now. Set <merge> to false
+  // if the device cannot auto-increment, so that the job is always read
+  // on its own. <period> must not be 0. Returns the job number, or
+  // SWI2C_SCHED_FULL if all JOBS are in use or <period> is 0.
+  uint8_t addJob(DEVICE& device, uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                 unsigned long period, unsigned long phase = 0, bool merge = true);
+  void setEnabled(uint8_t job, bool enabled);
+
+  // Reads the jobs that are due. If <budget> is not 0, no new read is
+  // started once <budget> us have passed, and the remaining due jobs are
+  // read by the next run(). Returns the number of jobs read.
+  uint8_t run(unsigned long budget = 0);
+  // us until the next enabled job is due, 0 if one is due now
+  unsigned long nextDue();
+
+  // True if the job's buffer was updated since the last call
+  bool isUpdated(uint8_t job);
+  // Result of the job's last read (1 if successful, 0 if a NACK was received)
+  int getLastResult(uint8_t job) {return _jobs[job].result;}
+
+  // Registers that are not needed by any job, but may be read to merge two jobs. Default 2.
+  void setMergeGap(uint8_t gap) {_gap = gap;}
+  uint8_t getMergeGap() {return _gap;}
+
+  const SWI2C_JobStats& getStats(uint8_t job) {return _jobs[job].stats;}
+  // Bus transactions used by run(). Less than the total runs when jobs are merged.
+  uint32_t getReads() {return _reads;}
+  void resetStats();
+
+private:
+  enum {ENABLED = 0x01, MERGE = 0x02, UPDATED = 0x04, IN_BURST = 0x08, DONE = 0x10};
+  struct Job {
+    DEVICE* device;
+    uint8_t* buffer;
+    unsigned long period;
+    unsigned long due;
+    uint8_t reg;
+    uint8_t count;
+    uint8_t flags;
+    int result;
+    SWI2C_JobStats stats;
+  };
+
+  unsigned long now() {return _jobs[0].device->getBus().getMicros();}
+  bool isDue(uint8_t job, unsigned long t) {
+    return (_jobs[job].flags & (ENABLED | DONE)) == ENABLED && (long)(t - _jobs[job].due) >= 0;
+  }
+  void finish(uint8_t job, unsigned long start, int result);
+
+  Job _jobs[JOBS];
+  uint8_t _count;
+  uint8_t _gap;
+  uint32_t _reads;
+  uint8_t _burst[BURST];
+};
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST>
+SWI2CScheduler<DEVICE, JOBS, BURST>::SWI2CScheduler() {
+  _count = 0;
+  _gap = 2;
+  _reads = 0;
+}
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST>
+uint8_t SWI2CScheduler<DEVICE, JOBS, BURST>::addJob(DEVICE& device, uint8_t regAddress, uint8_t* buffer, uint8_t count,
+                                                    unsigned long period, unsigned long phase, bool merge) {
+  Job* job;
+
+  if (_count == JOBS || period == 0) return SWI2C_SCHED_FULL;
+  job = &_jobs[_count];
+  job->device = &device;
+  job->buffer = buffer;
+  job->period = period;
+  job->reg = regAddress;
+  job->count = count;
+  job->flags = ENABLED | (merge ? MERGE : 0);
+  job->result = 0;
+  memset(&job->stats, 0, sizeof(job->stats));
+  job->due = device.getBus().getMicros() + phase;
+  return _count++;
+}
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST>
+void SWI2CScheduler<DEVICE, JOBS, BURST>::setEnabled(uint8_t job, bool enabled) {
+  if (job >= _count) return;
+  if (enabled && !(_jobs[job].flags & ENABLED)) _jobs[job].due = now();
+  if (enabled) _jobs[job].flags |= ENABLED;
+  else _jobs[job].flags &= ~ENABLED;
+}
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST>
+uint8_t SWI2CScheduler<DEVICE, JOBS, BURST>::run(unsigned long budget) {
+  unsigned long start;
+  unsigned long t;
+  uint8_t jobsRead = 0;
+  uint8_t first;
+  uint16_t lo, hi;        // Registers [lo, hi) read by the burst
+  uint8_t members;
+  bool added;
+  int result;
+
+  if (_count == 0) return 0;
+  start = now();
+  // Each job is read at most once per run(), so a bus that is too slow
+  // for the jobs cannot keep run() from returning
+  for (uint8_t j = 0; j < _count; j++) _jobs[j].flags &= ~DONE;
+  for (;;) {
+    t = now();
+    if (budget && t - start >= budget) break;
+
+    // Earliest deadline first: the due job whose period ends soonest
+    first = SWI2C_SCHED_FULL;
+    for (uint8_t j = 0; j < _count; j++) {
+      if (!isDue(j, t)) continue;
+      if (first == SWI2C_SCHED_FULL ||
+          (long)((_jobs[j].due + _jobs[j].period) - (_jobs[first].due + _jobs[first].period)) < 0) first = j;
+    }
+    if (first == SWI2C_SCHED_FULL) break;
+
+    // Add other due jobs on the same device that are close enough to the burst
+    lo = _jobs[first].reg;
+    hi = lo + _jobs[first].count;
+    _jobs[first].flags |= IN_BURST;
+    members = 1;
+    do {
+      added = false;
+      if (!(_jobs[first].flags & MERGE)) break;
+      for (uint8_t j = 0; j < _count; j++) {
+        Job& job = _jobs[j];
+        uint16_t newLo, newHi;
+        if ((job.flags & (IN_BURST | MERGE)) != MERGE || job.device != _jobs[first].device || !isDue(j, t)) continue;
+        // More than getMergeGap() registers between the job and the burst: [lo, hi) is the burst
+        if (job.reg > hi + _gap || job.reg + job.count + _gap < lo) continue;
+        newLo = job.reg < lo ? job.reg : lo;
+        newHi = job.reg + job.count > hi ? job.reg + job.count : hi;
+        if (newHi - newLo > BURST) continue;
+        lo = newLo;
+        hi = newHi;
+        job.flags |= IN_BURST;
+        members++;
+        added = true;
+      }
+    } while (added);
+
+    if (members == 1) result = _jobs[first].device->readFromRegister(lo, _jobs[first].buffer, hi - lo);
+    else result = _jobs[first].device->readFromRegister(lo, _burst, hi - lo);
+    _reads++;
+    for (uint8_t j = 0; j < _count; j++) {
+      if (!(_jobs[j].flags & IN_BURST)) continue;
+      if (members > 1 && result) memcpy(_jobs[j].buffer, &_burst[_jobs[j].reg - lo], _jobs[j].count);
+      finish(j, t, result);
+      jobsRead++;
+    }
+  }
+  return jobsRead;
+}
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST>
+void SWI2CScheduler<DEVICE, JOBS, BURST>::finish(uint8_t job, unsigned long start, int result) {
+  Job& j = _jobs[job];
+  unsigned long late = start - j.due;
+  unsigned long missed = late / j.period;
+
+  j.flags = (j.flags & ~IN_BURST) | DONE;
+  j.result = result;
+  if (result) j.flags |= UPDATED;
+  else j.stats.failures++;
+  j.stats.runs++;
+  j.stats.overruns += missed;
+  j.stats.lastLate = late;
+  if (late > j.stats.maxLate) j.stats.maxLate = late;
+  j.stats.totalLate += late;
+  // Keep the original phase: the next read is due at the start of the next period
+  j.due += (missed + 1) * j.period;
+}
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST>
+unsigned long SWI2CScheduler<DEVICE, JOBS, BURST>::nextDue() {
+  unsigned long t;
+  unsigned long wait = 0xFFFFFFFFUL;
+
+  if (_count == 0) return wait;
+  t = now();
+  for (uint8_t j = 0; j < _count; j++) {
+    if (!(_jobs[j].flags & ENABLED)) continue;
+    if ((long)(t - _jobs[j].due) >= 0) return 0;
+    if (_jobs[j].due - t < wait) wait = _jobs[j].due - t;
+  }
+  return wait;
+}
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST>
+bool SWI2CScheduler<DEVICE, JOBS, BURST>::isUpdated(uint8_t job) {
+  bool updated = _jobs[job].flags & UPDATED;
+  _jobs[job].flags &= ~UPDATED;
+  return updated;
+}
+
+template <class DEVICE, uint8_t JOBS, uint8_t BURST>
+void SWI2CScheduler<DEVICE, JOBS, BURST>::resetStats() {
+  for (uint8_t j = 0; j < _count; j++) memset(&_jobs[j].stats, 0, sizeof(_jobs[j].stats));
+  _reads = 0;
+}
+
+#endif
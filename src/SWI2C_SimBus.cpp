@@ -0,0 +1,785 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Simulated I2C bus
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Add simulated time and time source counters
+   10/16/2026 - Andy4495 - Add SWI2CBusSim
+   10/16/2026 - Andy4495 - Add SWI2C_SimFifoDevice
+   10/16/2026 - Andy4495 - Add SWI2CMultiSim
+   10/16/2026 - Andy4495 - Add SWI2CBusSimTrace
+   10/16/2026 - Andy4495 - Add SWI2C_SimEEPROMDevice
+   10/16/2026 - Andy4495 - Add SWI2C_SimSMBusDevice
+   10/16/2026 - Andy4495 - Add software targets (setTarget(), SWI2CTargetSim)
+*/
+
+#include "SWI2C_SimBus.h"
+
+SWI2C_SimDevice::SWI2C_SimDevice(uint8_t address) {
+  _address = address;
+  _stretch = 0;
+  _nackAddress = false;
+  _nackAfter = 0;
+  _bytesWritten = 0;
+  _bus = 0;
+  next = 0;
+}
+
+uint8_t SWI2C_SimDevice::onAddress(uint8_t /* r_w */) {
+  return !_nackAddress;
+}
+
+uint8_t SWI2C_SimDevice::onWrite(uint8_t /* data */) {
+  return 1;
+}
+
+uint8_t SWI2C_SimDevice::onRead() {
+  return 0xFF;
+}
+
+void SWI2C_SimDevice::onStop() {
+}
+
+SWI2C_SimRegisterDevice::SWI2C_SimRegisterDevice(uint8_t address, uint8_t* registers, uint16_t size) : SWI2C_SimDevice(address) {
+  _registers = registers;
+  _size = size;
+  _pointer = 0;
+  _pointerSet = false;
+}
+
+uint8_t SWI2C_SimRegisterDevice::onAddress(uint8_t r_w) {
+  // Register pointer is only set by the first byte of a write
+  if (r_w == 0) _pointerSet = false;
+  return SWI2C_SimDevice::onAddress(r_w);
+}
+
+uint8_t SWI2C_SimRegisterDevice::onWrite(uint8_t data) {
+  if (!_pointerSet) {
+    _pointer = data % _size;
+    _pointerSet = true;
+  }
+  else {
+    _registers[_pointer] = data;
+    if (++_pointer >= _size) _pointer = 0;
+  }
+  return 1;
+}
+
+uint8_t SWI2C_SimRegisterDevice::onRead() {
+  uint8_t value = _registers[_pointer];
+  if (++_pointer >= _size) _pointer = 0;
+  return value;
+}
+
+SWI2C_SimPortDevice::SWI2C_SimPortDevice(uint8_t address) : SWI2C_SimDevice(address) {
+  _port = 0xFF;
+}
+
+uint8_t SWI2C_SimPortDevice::onWrite(uint8_t data) {
+  _port = data;
+  return 1;
+}
+
+uint8_t SWI2C_SimPortDevice::onRead() {
+  return _port;
+}
+
+SWI2C_SimFifoDevice::SWI2C_SimFifoDevice(uint8_t address, uint8_t countRegister, uint8_t dataRegister) : SWI2C_SimDevice(address) {
+  _countRegister = countRegister;
+  _dataRegister = dataRegister;
+  _pointer = 0;
+  _pointerSet = false;
+  _count = 0;
+  _nextIn = 0;
+  _nextOut = 0;
+  _countLatched = 0;
+}
+
+uint8_t SWI2C_SimFifoDevice::onAddress(uint8_t r_w) {
+  if (r_w == 0) _pointerSet = false;
+  return SWI2C_SimDevice::onAddress(r_w);
+}
+
+uint8_t SWI2C_SimFifoDevice::onWrite(uint8_t data) {
+  // Only the register pointer can be written
+  if (_pointerSet) return 0;
+  _pointer = data;
+  _pointerSet = true;
+  return 1;
+}
+
+uint8_t SWI2C_SimFifoDevice::onRead() {
+  uint8_t value = 0;
+  if (_pointer == _dataRegister) {   // FIFO data: pointer does not increment
+    if (_count == 0) return 0;
+    _count--;
+    return _nextOut++;
+  }
+  if (_pointer == _countRegister) {
+    _countLatched = _count;
+    value = _countLatched >> 8;
+  }
+  else if (_pointer == (uint8_t)(_countRegister + 1)) value = _countLatched & 0xFF;
+  _pointer++;
+  return value;
+}
+
+void SWI2C_SimFifoDevice::fill(uint16_t count) {
+  if (count > 65535U - _count) count = 65535U - _count;
+  _count += count;
+  _nextIn += count;
+}
+
+SWI2C_SimEEPROMDevice::SWI2C_SimEEPROMDevice(uint8_t address, uint8_t* memory, uint16_t size, uint16_t pageSize,
+                                             uint8_t addressBytes, unsigned long writeTime) : SWI2C_SimDevice(address) {
+  _memory = memory;
+  _size = size;
+  _pageSize = pageSize;
+  _addressBytes = addressBytes;
+  _writeTime = writeTime;
+  _pointer = 0;
+  _addressCount = 0;
+  _dataWritten = false;
+  _busy = false;
+  _writeStart = 0;
+  _writeCycles = 0;
+}
+
+bool SWI2C_SimEEPROMDevice::isBusy() {
+  if (_busy && _bus->getMicros() - _writeStart >= _writeTime) _busy = false;
+  return _busy;
+}
+
+uint8_t SWI2C_SimEEPROMDevice::onAddress(uint8_t r_w) {
+  if (isBusy()) return 0;   // No ACK during the write cycle
+  if (r_w == 0) {
+    _addressCount = 0;
+    _dataWritten = false;
+  }
+  return SWI2C_SimDevice::onAddress(r_w);
+}
+
+uint8_t SWI2C_SimEEPROMDevice::onWrite(uint8_t data) {
+  uint16_t page;
+  if (_addressCount < _addressBytes) {
+    _pointer = (_addressCount == 0) ? data : (_pointer << 8) | data;
+    if (++_addressCount == _addressBytes) _pointer %= _size;
+    return 1;
+  }
+  _memory[_pointer] = data;
+  page = _pointer - _pointer % _pageSize;
+  _pointer = page + (_pointer + 1 - page) % _pageSize;   // Wraps within the page
+  _dataWritten = true;
+  return 1;
+}
+
+uint8_t SWI2C_SimEEPROMDevice::onRead() {
+  uint8_t value = _memory[_pointer];
+  if (++_pointer >= _size) _pointer = 0;
+  return value;
+}
+
+void SWI2C_SimEEPROMDevice::onStop() {
+  if (!_dataWritten) return;
+  _dataWritten = false;
+  _busy = true;
+  _writeStart = _bus->getMicros();
+  _writeCycles++;
+}
+
+SWI2C_SimSMBusDevice::SWI2C_SimSMBusDevice(uint8_t address, uint16_t* words, uint8_t wordCount,
+                                           uint8_t blockCommand, uint8_t* block, uint8_t blockSize) : SWI2C_SimDevice(address) {
+  _words = words;
+  _wordCount = wordCount;
+  _blockCommand = blockCommand;
+  _block = block;
+  _blockSize = blockSize;
+  _blockLength = 0;
+  _usePec = false;
+  _corruptPec = false;
+  _pec = 0;
+  _command = 0;
+  _index = 0;
+  _written = false;
+  _checkPec = false;
+  _endPec = 0;
+  _wordLow = 0;
+  _byte = 0;
+  _pecErrors = 0;
+}
+
+uint8_t SWI2C_SimSMBusDevice::onAddress(uint8_t r_w) {
+  if (!SWI2C_SimDevice::onAddress(r_w)) return 0;
+  // A write starts a new transaction. A read continues the PEC of the write
+  // before a repeated START.
+  if (r_w == 0) {
+    getPecErrors();
+    _pec = 0;
+    _written = false;
+  }
+  _checkPec = false;
+  _pec = SWI2C_crc8(_pec, (_address << 1) | r_w);
+  _index = 0;
+  return 1;
+}
+
+uint8_t SWI2C_SimSMBusDevice::onWrite(uint8_t data) {
+  _pec = SWI2C_crc8(_pec, data);
+  _written = true;
+  if (_index == 0) _command = data;
+  else if (_command == _blockCommand) {
+    if (_index == 1) _blockLength = (data < _blockSize) ? data : _blockSize;
+    else if (_index - 2 < _blockLength) _block[_index - 2] = data;
+  }
+  else if (_command < _wordCount) {
+    if (_index == 1) _wordLow = data;
+    else if (_index == 2) _words[_command] = _wordLow | (data << 8);
+  }
+  else if (_index == 1) _wordLow = data;   // Byte register, or the PEC of a send byte
+  _index++;
+  return 1;
+}
+
+uint8_t SWI2C_SimSMBusDevice::onRead() {
+  uint8_t value = 0xFF;
+  uint8_t length = 2;    // Bytes before the PEC
+
+  if (_command == _blockCommand) {
+    length = _blockLength + 1;
+    if (_index == 0) value = _blockLength;
+    else if (_index < length) value = _block[_index - 1];
+  }
+  else if (_command < _wordCount && _index < 2) {
+    value = (_index == 0) ? _words[_command] & 0xFF : _words[_command] >> 8;
+  }
+  else if (_command >= _wordCount) {
+    length = 1;
+    if (_index == 0) value = _byte;
+  }
+  if (_index == length) value = _corruptPec ? ~_pec : _pec;
+  _pec = SWI2C_crc8(_pec, value);
+  _index++;
+  _written = false;   // PEC of a process call is checked by the controller
+  return value;
+}
+
+void SWI2C_SimSMBusDevice::onStop() {
+  // Write byte: command, data, and PEC if used
+  if (_written && _command >= _wordCount && _command != _blockCommand && _index == (_usePec ? 3 : 2)) _byte = _wordLow;
+  _checkPec = _written && _usePec;
+  _endPec = _pec;
+  _written = false;
+}
+
+unsigned long SWI2C_SimSMBusDevice::getPecErrors() {
+  // A write ends with the PEC byte, so the CRC including it is 0
+  if (_checkPec && _endPec != 0) _pecErrors++;
+  _checkPec = false;
+  return _pecErrors;
+}
+
+SWI2C_SimBus::SWI2C_SimBus() {
+  _devices = 0;
+  _active = 0;
+  _controllerLow[LINE_SDA] = 0;
+  _controllerLow[LINE_SCL] = 0;
+  _deviceSdaLow = 0;
+  _stretchRemaining = 0;
+  _lastSda = HIGH;
+  _lastScl = HIGH;
+  _state = IDLE;
+  _bit = 0;
+  _shift = 0;
+  _r_w = 0;
+  _controllerAck = 0;
+  _transactionDone = true;
+  _writeNs = 1000;
+  _readNs = 1000;
+  _nsRemainder = 0;
+  _now = 0;
+  _handler = 0;
+  _interruptPeriod = 0;
+  _interruptAt = 0;
+  _interruptTime = 0;
+  _interrupts = 0;
+  _inInterrupt = false;
+  _nowNs = 0;
+  _target = 0;
+  _targetLatency = 0;
+  _targetOpNs = 0;
+  _targetLow[LINE_SDA] = 0;
+  _targetLow[LINE_SCL] = 0;
+  _targetOut[LINE_SDA] = 0;
+  _targetOut[LINE_SCL] = 0;
+  _targetLevels = 0x03;
+  _targetPending = false;
+  _inTarget = false;
+  _targetDue = 0;
+  _targetClock = 0;
+  _targetBusyUntil = 0;
+  _sclReleased = 0;
+  _targetHold = 0;
+  _nextLine = 0xFF;
+  _nextLow = 0;
+  _targetHead = 0;
+  _targetCount = 0;
+  resetCounters();
+}
+
+void SWI2C_SimBus::attach(SWI2C_SimDevice& device) {
+  device.next = _devices;
+  device._bus = this;
+  _devices = &device;
+}
+
+void SWI2C_SimBus::resetCounters() {
+  memset(&_total, 0, sizeof(_total));
+  memset(&_transaction, 0, sizeof(_transaction));
+}
+
+uint8_t SWI2C_SimBus::level(uint8_t line) {
+  if (line == LINE_SDA) return (_controllerLow[LINE_SDA] || _deviceSdaLow || _targetLow[LINE_SDA]) ? LOW : HIGH;
+  return (_controllerLow[LINE_SCL] || _stretchRemaining || _targetLow[LINE_SCL]) ? LOW : HIGH;
+}
+
+void SWI2C_SimBus::startCount() {
+  // A transaction's counts run from the first pin operation after a STOP
+  if (_transactionDone) {
+    memset(&_transaction, 0, sizeof(_transaction));
+    _transactionDone = false;
+  }
+}
+
+void SWI2C_SimBus::setPinTiming(unsigned int writeNs, unsigned int readNs) {
+  _writeNs = writeNs;
+  _readNs = readNs;
+}
+
+void SWI2C_SimBus::advance(unsigned int ns) {
+  unsigned long us;
+  _nsRemainder += ns % 1000;
+  us = ns / 1000 + _nsRemainder / 1000;
+  _nsRemainder %= 1000;
+  _now += us;
+  _nowNs += ns;
+  _total.busTime += us;
+  _transaction.busTime += us;
+}
+
+void SWI2C_SimBus::idle(unsigned long us) {
+  // Interrupts due during the idle time run at the time they are due, and
+  // the time spent in them is added
+  long wait;
+  for (;;) {
+    wait = (long)(_interruptAt - _now);
+    if (!_handler || _inInterrupt || wait > (long)us) break;
+    if (wait > 0) {
+      _now += wait;
+      _nowNs += wait * 1000;
+      us -= wait;
+    }
+    runTarget();
+    interrupt();
+  }
+  _now += us;
+  _nowNs += us * 1000;
+  runTarget();
+}
+
+void SWI2C_SimBus::setInterrupt(void (*handler)(), unsigned long periodUs, unsigned long firstUs) {
+  _handler = handler;
+  _interruptPeriod = periodUs;
+  _interruptAt = _now + firstUs;
+}
+
+void SWI2C_SimBus::interrupt() {
+  // Called after each controller operation: runs the handler if it is due
+  void (*handler)() = _handler;
+  if (!handler || _inInterrupt || (long)(_now - _interruptAt) < 0) return;
+  _interruptTime = _interruptAt;
+  if (_interruptPeriod) {
+    // Periods missed while the handler could not run are dropped, as with a hardware interrupt flag
+    while ((long)(_now - _interruptAt) >= 0) _interruptAt += _interruptPeriod;
+  }
+  else _handler = 0;
+  _interrupts++;
+  _inInterrupt = true;
+  handler();
+  _inInterrupt = false;
+}
+
+unsigned long SWI2C_SimBus::getMillis() {
+  unsigned long ms;
+  startCount();
+  _total.timeReads++;
+  _transaction.timeReads++;
+  advance(_readNs);
+  runTarget();
+  ms = _now / 1000;
+  interrupt();
+  return ms;
+}
+
+void SWI2C_SimBus::release(uint8_t line) {
+  startCount();
+  _total.pinWrites++;
+  _transaction.pinWrites++;
+  advance(_writeNs);
+  runTarget(line, 0);
+  _controllerLow[line] = 0;
+  if (line == LINE_SCL) _sclReleased = _nowNs;
+  update();
+  targetChanged(_nowNs);
+  interrupt();
+}
+
+void SWI2C_SimBus::driveLow(uint8_t line) {
+  startCount();
+  _total.pinWrites++;
+  _transaction.pinWrites++;
+  advance(_writeNs);
+  runTarget(line, 1);
+  _controllerLow[line] = 1;
+  update();
+  targetChanged(_nowNs);
+  interrupt();
+}
+
+uint8_t SWI2C_SimBus::read(uint8_t line) {
+  uint8_t value;
+  startCount();
+  _total.pinReads++;
+  _transaction.pinReads++;
+  advance(_readNs);
+  runTarget();
+  if (line == LINE_SCL && !_controllerLow[LINE_SCL] && _stretchRemaining) {
+    // Device is holding SCL low. Let it go after the configured number of samples.
+    _total.stretchReads++;
+    _transaction.stretchReads++;
+    _stretchRemaining--;
+    update();
+    targetChanged(_nowNs);
+  }
+  else if (line == LINE_SCL && !_controllerLow[LINE_SCL] && _targetLow[LINE_SCL]) {
+    _total.stretchReads++;
+    _transaction.stretchReads++;
+  }
+  value = level(line);
+  interrupt();
+  return value;
+}
+
+void SWI2C_SimBus::setTarget(void (*handler)(), unsigned int latencyNs, unsigned int opNs) {
+  _target = handler;
+  _targetLatency = latencyNs;
+  _targetOpNs = opNs;
+  _targetPending = false;
+  _targetBusyUntil = _nowNs;
+  _targetLevels = level(LINE_SDA) | (level(LINE_SCL) << 1);
+}
+
+uint8_t SWI2C_SimBus::targetRead(uint8_t line) {
+  uint8_t value, low;
+  if (!_inTarget) return level(line);
+  _targetClock += _targetOpNs;
+  // The handler runs all at once before the controller's next pin write.
+  // Reads timed after that write see its result.
+  if (line == _nextLine && (long)(_targetClock - _nowNs) >= 0) {
+    low = _controllerLow[line];
+    _controllerLow[line] = _nextLow;
+    value = level(line);
+    _controllerLow[line] = low;
+    return value;
+  }
+  return level(line);
+}
+
+void SWI2C_SimBus::targetWrite(uint8_t line, uint8_t low) {
+  TargetWrite* w;
+  _targetOut[line] = low;
+  // Outside the handler (e.g. begin() from setup()), or if the handler
+  // makes more writes than are kept, the write reaches the bus now
+  if (!_inTarget || _targetCount == TARGET_WRITES) {
+    applyTargetWrite(line, low, _nowNs);
+    return;
+  }
+  _targetClock += _targetOpNs;
+  w = &_targetWrites[(_targetHead + _targetCount) % (TARGET_WRITES)];
+  w->at = _targetClock;
+  w->line = line;
+  w->low = low;
+  _targetCount++;
+}
+
+void SWI2C_SimBus::applyTargetWrite(uint8_t line, uint8_t low, unsigned long at) {
+  uint8_t scl = level(LINE_SCL);
+  _targetLow[line] = low;
+  if (line == LINE_SCL && low) {
+    _targetHold = at;
+    if (scl == HIGH) {   // Too late: adds a clock pulse
+      _total.targetGlitches++;
+      _transaction.targetGlitches++;
+    }
+  }
+  if (line == LINE_SCL && scl == LOW && level(LINE_SCL) == HIGH && (long)(_sclReleased - _targetHold) >= 0) {
+    // The controller has been waiting for SCL since it released it
+    _total.targetStretch += at - _sclReleased;
+    _transaction.targetStretch += at - _sclReleased;
+  }
+  update();
+  targetChanged(at);
+}
+
+// Pin-change detection for the target: sets its interrupt flag
+void SWI2C_SimBus::targetChanged(unsigned long at) {
+  uint8_t levels = level(LINE_SDA) | (level(LINE_SCL) << 1);
+  if (levels == _targetLevels) return;
+  _targetLevels = levels;
+  if (!_target || _targetPending) return;
+  _targetPending = true;
+  _targetDue = at + _targetLatency;
+  if ((long)(_targetBusyUntil - _targetDue) > 0) _targetDue = _targetBusyUntil;
+}
+
+// Called before each controller operation: applies the target's pin writes
+// and runs its handler, in time order, up to the current time. <line> and
+// <low> are the controller pin write about to be made, if any.
+void SWI2C_SimBus::runTarget(uint8_t line, uint8_t low) {
+  void (*handler)() = _target;
+  bool write, call;
+  if (!handler || _inTarget) return;
+  _nextLine = line;
+  _nextLow = low;
+  for (;;) {
+    write = _targetCount && (long)(_targetWrites[_targetHead].at - _nowNs) <= 0;
+    call = _targetPending && (long)(_targetDue - _nowNs) <= 0;
+    if (write && call) {
+      if ((long)(_targetWrites[_targetHead].at - _targetDue) <= 0) call = false;
+      else write = false;
+    }
+    if (write) {
+      TargetWrite w = _targetWrites[_targetHead];
+      _targetHead = (_targetHead + 1) % (TARGET_WRITES);
+      _targetCount--;
+      applyTargetWrite(w.line, w.low, w.at);
+    }
+    else if (call) {
+      _targetPending = false;
+      _targetClock = _targetDue;
+      _total.targetCalls++;
+      _transaction.targetCalls++;
+      _inTarget = true;
+      handler();
+      _inTarget = false;
+      _targetBusyUntil = _targetClock;
+    }
+    else break;
+  }
+  _nextLine = 0xFF;
+}
+
+// Detect START, STOP, and SCL edges after any change on the bus
+void SWI2C_SimBus::update() {
+  uint8_t sda = level(LINE_SDA);
+  uint8_t scl = level(LINE_SCL);
+
+  if (scl == HIGH && _lastScl == HIGH && sda != _lastSda) {
+    if (sda == LOW) {  // START or repeated START
+      if (_active) _active->onStop();
+      _active = 0;
+      _deviceSdaLow = 0;
+      _state = ADDRESS;
+      _bit = 0;
+      _shift = 0;
+      _total.transactions++;
+      _transaction.transactions++;
+    }
+    else {             // STOP
+      if (_active) _active->onStop();
+      _active = 0;
+      _deviceSdaLow = 0;
+      _state = IDLE;
+      _transactionDone = true;
+    }
+    sda = level(LINE_SDA);
+  }
+  else if (scl == HIGH && _lastScl == LOW) {
+    onSclRise();
+  }
+  else if (scl == LOW && _lastScl == HIGH) {
+    onSclFall();
+    sda = level(LINE_SDA);
+  }
+  _lastSda = sda;
+  _lastScl = scl;
+}
+
+void SWI2C_SimBus::onSclRise() {
+  _total.sclPulses++;
+  _transaction.sclPulses++;
+  if (_state == ADDRESS || _state == WRITE) {
+    _shift = (_shift << 1) | level(LINE_SDA);
+    _bit++;
+  }
+  else if (_state == READ_ACK) {
+    _controllerAck = (level(LINE_SDA) == LOW);
+  }
+}
+
+// Devices change SDA only while SCL is low
+void SWI2C_SimBus::onSclFall() {
+  _deviceSdaLow = 0;
+  switch (_state) {
+    case ADDRESS:
+      if (_bit < 8) break;
+      _r_w = _shift & 0x01;
+      for (_active = _devices; _active; _active = _active->next) {
+        if (_active->_address == (_shift >> 1)) break;
+      }
+      if (_active && _active->onAddress(_r_w)) {
+        _active->_bytesWritten = 0;
+        _deviceSdaLow = 1;   // ACK
+        _state = ADDRESS_ACK;
+      }
+      else {
+        _active = 0;
+        _state = IGNORE;
+      }
+      break;
+    case ADDRESS_ACK:
+    case READ_ACK:
+      if (_state == READ_ACK && !_controllerAck) {  // NACK: controller is done reading
+        _state = IGNORE;
+        break;
+      }
+      if (_r_w) {
+        _shift = _active->onRead();
+        _bit = 0;
+        _deviceSdaLow = !(_shift & 0x80);
+        _state = READ;
+      }
+      else {
+        _shift = 0;
+        _bit = 0;
+        _state = WRITE;
+      }
+      break;
+    case WRITE:
+      if (_bit < 8) break;
+      if ((_active->_nackAfter == 0 || _active->_bytesWritten < _active->_nackAfter)
+          && _active->onWrite(_shift)) {
+        _active->_bytesWritten++;
+        _deviceSdaLow = 1;   // ACK
+        _state = WRITE_ACK;
+      }
+      else {
+        _state = IGNORE;
+      }
+      break;
+    case WRITE_ACK:
+      _shift = 0;
+      _bit = 0;
+      _state = WRITE;
+      break;
+    case READ:
+      if (++_bit < 8) _deviceSdaLow = !((_shift << _bit) & 0x80);
+      else _state = READ_ACK;   // Release SDA for ACK/NACK from controller
+      break;
+    default:
+      break;
+  }
+  if (_active) _stretchRemaining = _active->_stretch;
+}
+
+SWI2CSim::SWI2CSim(SWI2C_SimBus& bus, uint8_t deviceID) :
+  SWI2CCore<SWI2C_SimLine, SWI2C_SimLine>(SWI2C_SimLine(bus, SWI2C_SimBus::LINE_SDA), SWI2C_SimLine(bus, SWI2C_SimBus::LINE_SCL), deviceID) {
+}
+
+SWI2CBusSim::SWI2CBusSim(SWI2C_SimBus& bus) :
+  SWI2CBusCore<SWI2C_SimLine, SWI2C_SimLine>(SWI2C_SimLine(bus, SWI2C_SimBus::LINE_SDA), SWI2C_SimLine(bus, SWI2C_SimBus::LINE_SCL), true) {
+}
+
+SWI2CTargetSim::SWI2CTargetSim(SWI2C_SimBus& bus, uint8_t address) :
+  SWI2CTargetCore<SWI2C_SimTargetLine, SWI2C_SimTargetLine>(SWI2C_SimTargetLine(bus, SWI2C_SimBus::LINE_SDA), SWI2C_SimTargetLine(bus, SWI2C_SimBus::LINE_SCL), address) {
+}
+
+SWI2CBusSimTrace::SWI2CBusSimTrace(SWI2C_SimBus& bus, SWI2C_Trace& trace) :
+  SWI2CBusCore<SWI2C_TraceLine<SWI2C_SimLine>, SWI2C_TraceLine<SWI2C_SimLine> >(
+    SWI2C_TraceLine<SWI2C_SimLine>(SWI2C_SimLine(bus, SWI2C_SimBus::LINE_SDA), trace, SWI2C_TRACE_SDA),
+    SWI2C_TraceLine<SWI2C_SimLine>(SWI2C_SimLine(bus, SWI2C_SimBus::LINE_SCL), trace, SWI2C_TRACE_SCL), true) {
+}
+
+SWI2C_SimLanes::SWI2C_SimLanes(SWI2C_SimBus* const* buses, uint8_t count) {
+  if (count > SWI2C_MAX_LANES) count = SWI2C_MAX_LANES;
+  _count = count;
+  for (uint8_t i = 0; i < count; i++) _buses[i] = buses[i];
+  _released = 1;
+  _active = 0;
+}
+
+void SWI2C_SimLanes::begin() {
+  for (uint8_t i = 0; i < _count; i++) _buses[i]->release(SWI2C_SimBus::LINE_SDA);
+  _released = 1;
+  _active = 0;
+  setActive((1 << _count) - 1);
+}
+
+void SWI2C_SimLanes::release() {
+  _released = 1;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_active & (1 << i)) _buses[i]->release(SWI2C_SimBus::LINE_SDA);
+  }
+}
+
+void SWI2C_SimLanes::driveLow() {
+  _released = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_active & (1 << i)) _buses[i]->driveLow(SWI2C_SimBus::LINE_SDA);
+  }
+}
+
+uint8_t SWI2C_SimLanes::readAll() {
+  uint8_t bits = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_buses[i]->read(SWI2C_SimBus::LINE_SDA)) bits |= (1 << i);
+  }
+  return bits;
+}
+
+void SWI2C_SimLanes::setActive(uint8_t lanes) {
+  lanes &= (1 << _count) - 1;
+  for (uint8_t i = 0; i < _count; i++) {
+    uint8_t bit = 1 << i;
+    if ((_active & bit) && !(lanes & bit)) _buses[i]->release(SWI2C_SimBus::LINE_SDA);
+    if (!(_active & bit) && (lanes & bit) && !_released) _buses[i]->driveLow(SWI2C_SimBus::LINE_SDA);
+  }
+  _active = lanes;
+}
+
+SWI2C_SimSharedLine::SWI2C_SimSharedLine(SWI2C_SimBus* const* buses, uint8_t count, uint8_t line) {
+  if (count > SWI2C_MAX_LANES) count = SWI2C_MAX_LANES;
+  _count = count;
+  for (uint8_t i = 0; i < count; i++) _buses[i] = buses[i];
+  _line = line;
+}
+
+void SWI2C_SimSharedLine::release() {
+  for (uint8_t i = 0; i < _count; i++) _buses[i]->release(_line);
+}
+
+void SWI2C_SimSharedLine::driveLow() {
+  for (uint8_t i = 0; i < _count; i++) _buses[i]->driveLow(_line);
+}
+
+uint8_t SWI2C_SimSharedLine::read() {
+  uint8_t level = HIGH;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_buses[i]->read(_line) == LOW) level = LOW;
+  }
+  return level;
+}
+
+SWI2CMultiSim::SWI2CMultiSim(SWI2C_SimBus* const* buses, uint8_t count, uint8_t deviceID) :
+  SWI2CMultiCore<SWI2C_SimLanes, SWI2C_SimSharedLine>(SWI2C_SimLanes(buses, count), SWI2C_SimSharedLine(buses, count, SWI2C_SimBus::LINE_SCL), deviceID) {
+}
@@ -0,0 +1,488 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Simulated I2C bus
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+   10/16/2026 - Andy4495 - Add simulated time and time source counters
+   10/16/2026 - Andy4495 - Add SWI2CBusSim and SWI2CDeviceSim
+   10/16/2026 - Andy4495 - Add getMicros() to SWI2C_SimLine
+   10/16/2026 - Andy4495 - Add SWI2C_SimFifoDevice
+   10/16/2026 - Andy4495 - Add SWI2CMultiSim for several simulated buses with a shared SCL
+   10/16/2026 - Andy4495 - Add SWI2CBusSimTrace
+   10/16/2026 - Andy4495 - Add idle()
+   10/16/2026 - Andy4495 - Add SWI2C_SimEEPROMDevice
+   10/16/2026 - Andy4495 - Add SWI2C_SimSMBusDevice
+   10/16/2026 - Andy4495 - Add simulated interrupts (setInterrupt())
+   10/16/2026 - Andy4495 - Add software targets (setTarget(), SWI2CTargetSim)
+*/
+/* -----------------------------------------------------------------
+   A wired-AND open-drain bus model with pluggable target device models.
+
+   SWI2C_SimLine is a pin driver (see SWI2C_PinDriver.h) that drives a
+   SWI2C_SimBus instead of real pins, so the complete SWI2C protocol code
+   can be run without hardware -- on any board, or on a host PC with a
+   stub Arduino.h. SWI2CSim is the device class wired to a simulated bus:
+
+     SWI2C_SimBus bus;
+     uint8_t regs[128];
+     SWI2C_SimRegisterDevice mpu(0x68, regs, sizeof(regs));
+     bus.attach(mpu);
+     SWI2CSim myDevice(bus, 0x68);
+
+   SWI2CBusSim and SWI2CDeviceSim are the simulated equivalents of
+   SWI2CBus and SWI2CDevice. SWI2CMultiSim is the equivalent of
+   SWI2CMulti: each lane is a separate SWI2C_SimBus, and SCL is driven
+   on all of them together.
+
+   The bus counts every pin operation the controller makes, both in total
+   and for the most recent transaction (START to STOP).
+
+   The bus also keeps simulated time. Each pin write, pin read, and time
+   source read advances it by a configurable cost (setPinTiming()), and
+   getMillis() and getMicros() on the SCL line return simulated, not real,
+   time. Delays added for a bus speed (setSpeed()) do not touch the pins,
+   so they do not advance simulated time.
+
+   setInterrupt() models a hardware interrupt, such as a sensor's
+   data-ready pin. The handler is called when simulated time reaches the
+   interrupt, between two controller operations (even part way through a
+   byte), or during idle(). This makes interrupt timing repeatable, so
+   code that uses the bus from interrupt handlers (see SWI2C_Lock.h) can
+   be tested without hardware.
+
+   setTarget() puts a software target (SWI2C_Target.h) on the bus, so
+   the target code can be run against the controller code. The target
+   is a second microcontroller with its own clock: its handler runs a
+   set latency after each change on SDA or SCL, like a pin-change
+   interrupt, each of its pin operations takes a set time, and its pin
+   writes reach the bus at that time. A target that is too slow for the
+   controller misses edges, as it would on real hardware.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_SIMBUS_H
+#define SWI2C_SIMBUS_H
+
+#include <string.h>
+#include "Arduino.h"
+#include "SWI2C_Core.h"
+#include "SWI2C_Multi.h"
+#include "SWI2C_Trace.h"
+#include "SWI2C_SMBus.h"
+#include "SWI2C_Target.h"
+
+class SWI2C_SimBus;
+
+// Base class for simulated target devices. The default behavior ACKs its
+// address and every byte written, returns 0xFF for reads, and never
+// stretches the clock. Device models override the on*() methods.
+class SWI2C_SimDevice {
+public:
+  SWI2C_SimDevice(uint8_t address);
+  virtual ~SWI2C_SimDevice() {}
+
+  // Called after the address byte matches. Return 1 to ACK, 0 to NACK.
+  virtual uint8_t onAddress(uint8_t r_w);
+  // Called for each byte written by the controller. Return 1 to ACK, 0 to NACK.
+  virtual uint8_t onWrite(uint8_t data);
+  // Called each time the controller clocks in a new byte from the device.
+  virtual uint8_t onRead();
+  // Called on STOP, or on a repeated START while addressed.
+  virtual void onStop();
+
+  uint8_t getAddress() {return _address;}
+  // Hold SCL low for <reads> controller samples after every falling SCL edge
+  void setClockStretch(unsigned int reads) {_stretch = reads;}
+  unsigned int getClockStretch() {return _stretch;}
+  // NACK the address byte (device absent or busy)
+  void setNackAddress(bool nack) {_nackAddress = nack;}
+  // NACK the written byte after <count> bytes have been ACKed in one transaction. 0 disables.
+  void setNackAfter(uint8_t count) {_nackAfter = count;}
+
+  SWI2C_SimDevice* next;   // Used by SWI2C_SimBus to link attached devices
+
+protected:
+  uint8_t _address;
+  unsigned int _stretch;
+  bool _nackAddress;
+  uint8_t _nackAfter;
+  uint8_t _bytesWritten;   // Bytes ACKed since address, used with setNackAfter()
+  SWI2C_SimBus* _bus;      // Set by SWI2C_SimBus::attach(), for models that need the simulated time
+  friend class SWI2C_SimBus;
+};
+
+// Register-file device (e.g. MPU6050): first byte written sets the register
+// pointer, following bytes are written to consecutive registers. Reads
+// return consecutive registers. The pointer wraps at <size>.
+class SWI2C_SimRegisterDevice : public SWI2C_SimDevice {
+public:
+  SWI2C_SimRegisterDevice(uint8_t address, uint8_t* registers, uint16_t size);
+  virtual uint8_t onAddress(uint8_t r_w);
+  virtual uint8_t onWrite(uint8_t data);
+  virtual uint8_t onRead();
+  uint16_t getRegisterPointer() {return _pointer;}
+
+protected:
+  uint8_t* _registers;
+  uint16_t _size;
+  uint16_t _pointer;
+  bool _pointerSet;
+};
+
+// Device without registers (e.g. PCF8574): a write sets the port value,
+// a read returns it.
+class SWI2C_SimPortDevice : public SWI2C_SimDevice {
+public:
+  SWI2C_SimPortDevice(uint8_t address);
+  virtual uint8_t onWrite(uint8_t data);
+  virtual uint8_t onRead();
+  uint8_t getPort() {return _port;}
+  void setPort(uint8_t value) {_port = value;}
+
+protected:
+  uint8_t _port;
+};
+
+// Device with a FIFO (e.g. the MPU6050 FIFO): a 2-byte count register (MSB
+// first) at <countRegister> and <countRegister> + 1, and a data register that
+// returns the next FIFO byte on each read without incrementing the register
+// pointer. The FIFO holds a byte sequence counting up from 0, and holds at most 65535 bytes.
+class SWI2C_SimFifoDevice : public SWI2C_SimDevice {
+public:
+  SWI2C_SimFifoDevice(uint8_t address, uint8_t countRegister, uint8_t dataRegister);
+  virtual uint8_t onAddress(uint8_t r_w);
+  virtual uint8_t onWrite(uint8_t data);
+  virtual uint8_t onRead();
+  // Adds <count> bytes to the FIFO
+  void fill(uint16_t count);
+  uint16_t getCount() {return _count;}
+  // Value of the next byte added by fill()
+  uint8_t getNextValue() {return _nextIn;}
+
+protected:
+  uint8_t _countRegister;
+  uint8_t _dataRegister;
+  uint8_t _pointer;
+  bool _pointerSet;
+  uint16_t _count;
+  uint8_t _nextIn;     // Next value added by fill()
+  uint8_t _nextOut;    // Next value read from the FIFO
+  uint16_t _countLatched;   // Count register value, captured when the MSB is read
+};
+
+// 24Cxx-style EEPROM. The first <addressBytes> bytes of a write (MSB first)
+// set the memory address, and the following bytes are written within the
+// current page, wrapping at the page boundary like a real EEPROM. A STOP
+// after data bytes starts a write cycle: the device NACKs its address for
+// <writeTime> us of simulated time. Reads are sequential and wrap at <size>.
+class SWI2C_SimEEPROMDevice : public SWI2C_SimDevice {
+public:
+  SWI2C_SimEEPROMDevice(uint8_t address, uint8_t* memory, uint16_t size, uint16_t pageSize,
+                        uint8_t addressBytes, unsigned long writeTime);
+  virtual uint8_t onAddress(uint8_t r_w);
+  virtual uint8_t onWrite(uint8_t data);
+  virtual uint8_t onRead();
+  virtual void onStop();
+  bool isBusy();
+  // Number of write cycles (page writes) started
+  unsigned long getWriteCycles() {return _writeCycles;}
+
+protected:
+  uint8_t* _memory;
+  uint16_t _size;
+  uint16_t _pageSize;
+  uint8_t _addressBytes;
+  unsigned long _writeTime;
+  uint16_t _pointer;
+  uint8_t _addressCount;   // Memory address bytes received in this write
+  bool _dataWritten;
+  bool _busy;
+  unsigned long _writeStart;
+  unsigned long _writeCycles;
+};
+
+// SMBus device (e.g. a Smart Battery): commands below <wordCount> are word
+// registers (LSB first), and <blockCommand> is a block of up to <blockSize>
+// bytes with a length byte. Any other command is a one-byte register for
+// the byte commands (getByte()). A write to a word register followed by a
+// read in the same transaction is a process call, which returns the word written.
+// With setPEC(true), reads end with a PEC byte, and writes must end with a
+// correct PEC byte or they are counted by getPecErrors(). onStop() is also
+// called for a repeated START, so the PEC of a write is checked when the
+// next address is not a read continuing the same transaction.
+class SWI2C_SimSMBusDevice : public SWI2C_SimDevice {
+public:
+  SWI2C_SimSMBusDevice(uint8_t address, uint16_t* words, uint8_t wordCount,
+                       uint8_t blockCommand, uint8_t* block, uint8_t blockSize);
+  virtual uint8_t onAddress(uint8_t r_w);
+  virtual uint8_t onWrite(uint8_t data);
+  virtual uint8_t onRead();
+  virtual void onStop();
+  void setPEC(bool pec) {_usePec = pec;}
+  void setBlockLength(uint8_t length) {_blockLength = length;}
+  uint8_t getBlockLength() {return _blockLength;}
+  uint8_t getByte() {return _byte;}
+  unsigned long getPecErrors();
+  // Send a wrong PEC byte on reads (to test error handling)
+  void setCorruptPEC(bool corrupt) {_corruptPec = corrupt;}
+
+protected:
+  uint16_t* _words;
+  uint8_t _wordCount;
+  uint8_t _blockCommand;
+  uint8_t* _block;
+  uint8_t _blockSize;
+  uint8_t _blockLength;
+  bool _usePec;
+  bool _corruptPec;
+  uint8_t _pec;
+  uint8_t _command;
+  uint8_t _index;           // Bytes written after the address, or read since the address
+  bool _written;            // Data written in this transaction, PEC to check at STOP
+  bool _checkPec;           // Write ended: check its PEC unless a repeated START continues it
+  uint8_t _endPec;
+  uint8_t _wordLow;
+  uint8_t _byte;
+  unsigned long _pecErrors;
+};
+
+class SWI2C_SimBus {
+public:
+  enum Line {LINE_SDA = 0, LINE_SCL = 1};
+  struct Counters {
+    unsigned long pinWrites;      // Controller release() and driveLow() calls
+    unsigned long pinReads;       // Controller read() calls
+    unsigned long sclPulses;      // Rising SCL edges, i.e. bits clocked
+    unsigned long stretchReads;   // SCL reads that returned LOW due to clock stretching
+    unsigned long transactions;   // START conditions, including repeated STARTs
+    unsigned long timeReads;      // Controller getMillis() calls
+    unsigned long busTime;        // Simulated microseconds
+    unsigned long targetCalls;    // Software target handler calls (setTarget())
+    unsigned long targetStretch;  // Simulated ns the controller waited for SCL held by the software target
+    unsigned long targetGlitches; // Times the software target pulled SCL low after the controller released it
+  };
+
+  SWI2C_SimBus();
+  void attach(SWI2C_SimDevice& device);
+
+  // Used by SWI2C_SimLine
+  void release(uint8_t line);
+  void driveLow(uint8_t line);
+  uint8_t read(uint8_t line);
+  uint8_t isReleased(uint8_t line) {return !_controllerLow[line];}
+  unsigned long getMillis();
+
+  // Simulated cost of each controller operation, in nanoseconds. Default 1000 ns each.
+  void setPinTiming(unsigned int writeNs, unsigned int readNs);
+  // Simulated time since the bus was created
+  unsigned long getMicros() {return _now;}
+  // Advance simulated time with the bus idle, e.g. to model other work in loop()
+  void idle(unsigned long us);
+  // Calls <handler> every <periodUs> us of simulated time (only once if 0),
+  // starting <firstUs> us from now. A handler that runs past the next
+  // interrupt is called again right after it returns, and never nested.
+  // A null handler stops the interrupts.
+  void setInterrupt(void (*handler)(), unsigned long periodUs, unsigned long firstUs);
+  // Simulated time the current (or last) interrupt was due, to measure latency
+  unsigned long getInterruptTime() {return _interruptTime;}
+  unsigned long getInterrupts() {return _interrupts;}
+
+  // Software target (see SWI2C_Target.h) on this bus: <handler> is called
+  // <latencyNs> after a change on SDA or SCL, as a pin-change interrupt.
+  // Changes while it is pending or running call it once more, when it
+  // returns. Each target pin operation takes <opNs>. A null handler
+  // removes the target.
+  void setTarget(void (*handler)(), unsigned int latencyNs, unsigned int opNs);
+  // Used by SWI2C_SimTargetLine
+  void targetRelease(uint8_t line) {targetWrite(line, 0);}
+  void targetDriveLow(uint8_t line) {targetWrite(line, 1);}
+  uint8_t targetRead(uint8_t line);
+  uint8_t isTargetReleased(uint8_t line) {return !_targetOut[line];}
+
+  // Bus level as seen by all devices: low if anyone drives it low
+  uint8_t level(uint8_t line);
+  // Totals since the last resetCounters()
+  const Counters& getCounters() {return _total;}
+  // Counts from the last START through its STOP (or through now, if no STOP yet)
+  const Counters& getTransactionCounters() {return _transaction;}
+  void resetCounters();
+
+private:
+  enum State {IDLE, ADDRESS, ADDRESS_ACK, WRITE, WRITE_ACK, READ, READ_ACK, IGNORE};
+  void update();
+  void onSclRise();
+  void onSclFall();
+  void startCount();
+  void advance(unsigned int ns);
+  void interrupt();
+  void targetWrite(uint8_t line, uint8_t low);
+  void applyTargetWrite(uint8_t line, uint8_t low, unsigned long at);
+  void targetChanged(unsigned long at);
+  void runTarget(uint8_t line = 0xFF, uint8_t low = 0);
+
+  SWI2C_SimDevice* _devices;
+  SWI2C_SimDevice* _active;
+  uint8_t _controllerLow[2];
+  uint8_t _deviceSdaLow;
+  unsigned int _stretchRemaining;
+  uint8_t _lastSda;
+  uint8_t _lastScl;
+  State _state;
+  uint8_t _bit;
+  uint8_t _shift;
+  uint8_t _r_w;
+  uint8_t _controllerAck;
+  bool _transactionDone;
+  unsigned int _writeNs;
+  unsigned int _readNs;
+  unsigned int _nsRemainder;
+  unsigned long _now;
+  void (*_handler)();
+  unsigned long _interruptPeriod;
+  unsigned long _interruptAt;       // Simulated time the next interrupt is due
+  unsigned long _interruptTime;
+  unsigned long _interrupts;
+  bool _inInterrupt;
+  unsigned long _nowNs;             // Simulated time in ns, for the target (wraps every 4.3 s)
+  void (*_target)();
+  unsigned int _targetLatency;
+  unsigned int _targetOpNs;
+  uint8_t _targetLow[2];            // Target pin writes that have reached the bus
+  uint8_t _targetOut[2];            // Including writes still on their way
+  uint8_t _targetLevels;            // SDA and SCL levels the target's pin-change logic last saw
+  bool _targetPending;
+  bool _inTarget;
+  unsigned long _targetDue;         // ns
+  unsigned long _targetClock;       // ns, time of the running handler's next operation
+  unsigned long _targetBusyUntil;   // ns
+  unsigned long _sclReleased;       // ns, controller released SCL
+  unsigned long _targetHold;        // ns, target drove SCL low
+  uint8_t _nextLine;                // Controller pin write about to be made, 0xFF if none
+  uint8_t _nextLow;
+  struct TargetWrite {
+    unsigned long at;
+    uint8_t line;
+    uint8_t low;
+  };
+  enum {TARGET_WRITES = 4};
+  TargetWrite _targetWrites[TARGET_WRITES];   // Pin writes of the running handler, in time order
+  uint8_t _targetHead;
+  uint8_t _targetCount;
+  Counters _total;
+  Counters _transaction;
+};
+
+// Pin driver that connects one SWI2C line to a SWI2C_SimBus
+class SWI2C_SimLine {
+public:
+  SWI2C_SimLine(SWI2C_SimBus& bus, uint8_t line) : _bus(&bus), _line(line) {}
+  void begin() {_bus->release(_line);}
+  uint8_t getPin() {return _line;}
+  uint8_t isReleased() {return _bus->isReleased(_line);}
+  void release() {_bus->release(_line);}
+  void driveLow() {_bus->driveLow(_line);}
+  uint8_t read() {return _bus->read(_line);}
+  unsigned long getMillis() {return _bus->getMillis();}
+  unsigned long getMicros() {return _bus->getMicros();}
+
+private:
+  SWI2C_SimBus* _bus;
+  uint8_t _line;
+};
+
+// SWI2C device on a simulated bus. Same methods as SWI2C.
+class SWI2CSim : public SWI2CCore<SWI2C_SimLine, SWI2C_SimLine> {
+public:
+  SWI2CSim(SWI2C_SimBus& bus, uint8_t deviceID);
+};
+
+// Shared controller bus on a simulated bus, for use with SWI2CDeviceSim handles
+class SWI2CBusSim : public SWI2CBusCore<SWI2C_SimLine, SWI2C_SimLine> {
+public:
+  SWI2CBusSim(SWI2C_SimBus& bus);
+};
+
+typedef SWI2CDeviceT<SWI2CBusSim> SWI2CDeviceSim;
+
+// Pin driver for a software target on a SWI2C_SimBus (see setTarget())
+class SWI2C_SimTargetLine {
+public:
+  SWI2C_SimTargetLine(SWI2C_SimBus& bus, uint8_t line) : _bus(&bus), _line(line) {}
+  void begin() {_bus->targetRelease(_line);}
+  uint8_t getPin() {return _line;}
+  uint8_t isReleased() {return _bus->isTargetReleased(_line);}
+  void release() {_bus->targetRelease(_line);}
+  void driveLow() {_bus->targetDriveLow(_line);}
+  uint8_t read() {return _bus->targetRead(_line);}
+
+private:
+  SWI2C_SimBus* _bus;
+  uint8_t _line;
+};
+
+// Software target on a simulated bus. Same methods as SWI2CTarget.
+class SWI2CTargetSim : public SWI2CTargetCore<SWI2C_SimTargetLine, SWI2C_SimTargetLine> {
+public:
+  SWI2CTargetSim(SWI2C_SimBus& bus, uint8_t address);
+};
+
+// Shared controller bus on a simulated bus, with both lines traced.
+// Timestamps are simulated time.
+class SWI2CBusSimTrace : public SWI2CBusCore<SWI2C_TraceLine<SWI2C_SimLine>, SWI2C_TraceLine<SWI2C_SimLine> > {
+public:
+  SWI2CBusSimTrace(SWI2C_SimBus& bus, SWI2C_Trace& trace);
+};
+
+typedef SWI2CDeviceT<SWI2CBusSimTrace> SWI2CDeviceSimTrace;
+
+// Lanes driver for SWI2CMultiSim: SDA lane n is the SDA line of buses[n]
+class SWI2C_SimLanes {
+public:
+  SWI2C_SimLanes(SWI2C_SimBus* const* buses, uint8_t count);
+  void begin();
+  uint8_t getPin(uint8_t lane = 0) {return lane;}
+  uint8_t getLaneCount() {return _count;}
+  uint8_t isReleased() {return _released;}
+  void release();
+  void driveLow();
+  uint8_t readAll();
+  uint8_t laneBit(uint8_t lane) {return 1 << lane;}
+  uint8_t read() {return ((readAll() & _active) == _active) ? HIGH : LOW;}
+  void setActive(uint8_t lanes);
+  uint8_t getActive() {return _active;}
+
+private:
+  SWI2C_SimBus* _buses[SWI2C_MAX_LANES];
+  uint8_t _count;
+  uint8_t _released;
+  uint8_t _active;
+};
+
+// The same line (normally SCL) on several simulated buses. Reads low if
+// any bus is low, for example because a device is stretching the clock.
+class SWI2C_SimSharedLine {
+public:
+  SWI2C_SimSharedLine(SWI2C_SimBus* const* buses, uint8_t count, uint8_t line);
+  void begin() {release();}
+  uint8_t getPin() {return _line;}
+  uint8_t isReleased() {return _count ? _buses[0]->isReleased(_line) : 1;}
+  void release();
+  void driveLow();
+  uint8_t read();
+  unsigned long getMillis() {return _buses[0]->getMillis();}
+  unsigned long getMicros() {return _buses[0]->getMicros();}
+
+private:
+  SWI2C_SimBus* _buses[SWI2C_MAX_LANES];
+  uint8_t _count;
+  uint8_t _line;
+};
+
+// SWI2CMulti on simulated buses, one per lane. Same methods as SWI2CMulti.
+class SWI2CMultiSim : public SWI2CMultiCore<SWI2C_SimLanes, SWI2C_SimSharedLine> {
+public:
+  SWI2CMultiSim(SWI2C_SimBus* const* buses, uint8_t count, uint8_t deviceID);
+};
+
+#endif
@@ -0,0 +1,73 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Transaction statistics
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   Optional per-device statistics, collected by the high level methods.
+   Enabled by defining SWI2C_STATS as 1 for the whole build, in the same
+   way as SWI2C_PIN_DRIVER (for example, -DSWI2C_STATS=1 in the compiler
+   flags). When SWI2C_STATS is 0 (the default), none of the statistics
+   code or data is compiled in.
+
+     SWI2C_Stats s;
+     myDevice.snapshotStats(s, true);   // Copy and reset
+     Serial.println(s.transactions[SWI2C_OP_READ]);
+
+   Latency is the time of a whole high level call, including retries,
+   measured with micros(). Bucket <n> of the histogram counts calls that
+   took less than (SWI2C_STATS_BUCKET0_US << n) us; the last bucket
+   also counts everything longer.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_STATS_H
+#define SWI2C_STATS_H
+
+#include "Arduino.h"
+
+#ifndef SWI2C_STATS
+#define SWI2C_STATS 0
+#endif
+
+// Operation types
+#define SWI2C_OP_WRITE   0    // writeTo...() methods
+#define SWI2C_OP_READ    1    // readFrom...() and streamFromRegister()
+#define SWI2C_OP_COUNT   2
+
+// Phase of a NACK
+#define SWI2C_PHASE_ADDRESS   0   // Device address (either direction)
+#define SWI2C_PHASE_REGISTER  1   // Register address byte
+#define SWI2C_PHASE_DATA      2   // Data byte written to the device
+#define SWI2C_PHASE_COUNT     3
+
+#define SWI2C_STATS_BUCKETS     8
+#define SWI2C_STATS_BUCKET0_US  128UL   // Bucket 0: < 128 us, 1: < 256 us, ... 7: >= 8192 us
+
+struct SWI2C_Stats {
+  uint32_t transactions[SWI2C_OP_COUNT];   // High level calls
+  uint32_t failures[SWI2C_OP_COUNT];       // Calls that returned 0
+  uint32_t bytesOut;                       // Register and data bytes ACKed by the device
+  uint32_t bytesIn;                        // Data bytes read from the device
+  uint16_t retries;                        // Extra attempts made under the retry policy
+  uint16_t nacks[SWI2C_PHASE_COUNT];
+  uint16_t stretches;                      // Times the device held SCL low
+  uint16_t stretchTimeouts;
+  unsigned long longestStretch;            // us
+  uint16_t latency[SWI2C_OP_COUNT][SWI2C_STATS_BUCKETS];
+
+  void reset() {memset(this, 0, sizeof(*this));}
+  static uint8_t bucket(unsigned long us) {
+    uint8_t n = 0;
+    unsigned long limit = SWI2C_STATS_BUCKET0_US;
+    while (n < SWI2C_STATS_BUCKETS - 1 && us >= limit) {
+      n++;
+      limit <<= 1;
+    }
+    return n;
+  }
+};
+
+#endif
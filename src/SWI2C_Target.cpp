@@ -0,0 +1,13 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Software I2C target (slave)
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+
+#include "SWI2C_Target.h"
+
+SWI2CTarget::SWI2CTarget(uint8_t sda_pin, uint8_t scl_pin, uint8_t address) :
+  SWI2CTargetCore<SWI2C_PinLine, SWI2C_PinLine>(SWI2C_PinLine(sda_pin), SWI2C_PinLine(scl_pin), address) {
+}
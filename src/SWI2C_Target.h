@@ -0,0 +1,350 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Software I2C target (slave)
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   SWI2CTarget makes a microcontroller look like an I2C register-file
+   device (like the MPU6050) to a controller, using the same open-drain
+   pin drivers as the controller classes, so no TWI peripheral is needed:
+
+     uint8_t registers[16];
+     SWI2CTarget target(SDA_PIN, SCL_PIN, 0x42);
+
+     void onPinChange() {target.onPinChange();}
+
+     void setup() {
+       target.setRegisters(registers, sizeof(registers));
+       target.begin();
+       attachInterrupt(digitalPinToInterrupt(SDA_PIN), onPinChange, CHANGE);
+       attachInterrupt(digitalPinToInterrupt(SCL_PIN), onPinChange, CHANGE);
+     }
+
+   onPinChange() must be called on every change of SDA or SCL, normally
+   from a pin-change interrupt on both pins. It samples both lines and
+   works out what changed: SDA changing while SCL is high is a START or
+   STOP, otherwise it is a rising or falling SCL edge.
+
+   The first byte written after the address sets the register pointer,
+   and the following bytes are written to consecutive registers. Reads
+   return consecutive registers. The pointer wraps at the size of the
+   register file. The next byte to send is looked up in the register
+   file while SCL is high (on the rising edge of the ACK clock), so each
+   falling edge only has to put the next bit of a byte already in hand
+   on SDA.
+
+   A falling SCL edge where SDA must change (ACK, and each bit sent) has
+   a deadline: the new level must be on SDA before the controller raises
+   SCL again. With setClockStretch(true) (the default), the target holds
+   SCL low while it changes SDA, so a controller that raises SCL part way
+   through waits (the SWI2C controller classes support this). SCL is only
+   held for those few instructions, and only when SDA changes.
+
+   Edges are missed if the interrupt latency is longer than half a clock
+   period, so the bus must run slowly enough for the target. The
+   SWI2C_Target example measures the fastest clock a target keeps up
+   with, and the clock stretching per byte, on a simulated bus
+   (SWI2C_SimBus.h).
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_TARGET_H
+#define SWI2C_TARGET_H
+
+#include "Arduino.h"
+#include "SWI2C_PinDriver.h"
+
+struct SWI2C_TargetStats {
+  uint32_t pinChanges;        // onPinChange() calls
+  uint32_t addressed;         // Address matches, including repeated STARTs
+  uint32_t bytesWritten;      // Register bytes written by the controller
+  uint32_t bytesRead;         // Register bytes sent to the controller
+  uint32_t stretches;         // Falling edges where SCL was held while SDA changed
+  uint32_t late;              // SDA changes made after the controller had raised SCL again
+};
+
+// Called from onPinChange() at the STOP (or repeated START) that ends a
+// write of <count> registers starting at <regAddress>
+typedef void (*SWI2C_TargetWriteCallback)(uint8_t regAddress, uint8_t count);
+
+template <class SDA_LINE, class SCL_LINE>
+class SWI2CTargetCore {
+public:
+  SWI2CTargetCore(const SDA_LINE& sda, const SCL_LINE& scl, uint8_t address);
+  void begin();
+
+  // Register file served to the controller, <size> bytes, in the caller's storage
+  void setRegisters(uint8_t* registers, uint8_t size);
+  void setWriteCallback(SWI2C_TargetWriteCallback callback) {_onWrite = callback;}
+  // Hold SCL low while changing SDA after a falling edge (default true)
+  void setClockStretch(bool stretch) {_stretch = stretch;}
+  uint8_t getAddress() {return _address;}
+  uint8_t getRegisterPointer() {return _pointer;}
+  // True between a START addressed to this target and the STOP
+  bool isBusy() {return _state != IDLE && _state != IGNORE;}
+
+  // Call on every change of SDA or SCL
+  void onPinChange();
+
+  const SWI2C_TargetStats& getStats() {return _stats;}
+  void resetStats();
+
+private:
+  enum State {IDLE, ADDRESS, ADDRESS_ACK, WRITE, WRITE_ACK, READ, READ_ACK, IGNORE};
+  void start();
+  void stop();
+  void sclRise(uint8_t sda);
+  void sclFall();
+  void setSda(uint8_t level);
+  void releaseSda();
+  void endWrite();
+
+  SDA_LINE _sda;
+  SCL_LINE _scl;
+  uint8_t _address;
+  uint8_t* _registers;
+  uint8_t _size;
+  uint8_t _pointer;
+  bool _pointerSet;
+  uint8_t _writeStart;        // First register written in this transaction
+  uint8_t _writeCount;
+  SWI2C_TargetWriteCallback _onWrite;
+  bool _stretch;
+  volatile State _state;
+  uint8_t _lastSda;
+  uint8_t _lastScl;
+  uint8_t _sdaLevel;          // Level this target leaves on SDA
+  uint8_t _bit;               // Bits received in this byte
+  uint8_t _shift;             // Byte being received
+  uint8_t _tx;                // Byte being sent
+  uint8_t _mask;              // Bit of _tx on SDA
+  uint8_t _r_w;
+  uint8_t _controllerAck;
+  SWI2C_TargetStats _stats;
+};
+
+template <class SDA_LINE, class SCL_LINE>
+SWI2CTargetCore<SDA_LINE, SCL_LINE>::SWI2CTargetCore(const SDA_LINE& sda, const SCL_LINE& scl, uint8_t address) :
+  _sda(sda), _scl(scl) {
+  _address = address;
+  _registers = 0;
+  _size = 0;
+  _pointer = 0;
+  _pointerSet = false;
+  _writeStart = 0;
+  _writeCount = 0;
+  _onWrite = 0;
+  _stretch = true;
+  _state = IDLE;
+  _lastSda = HIGH;
+  _lastScl = HIGH;
+  _sdaLevel = HIGH;
+  _bit = 0;
+  _shift = 0;
+  _tx = 0xFF;
+  _mask = 0;
+  _r_w = 0;
+  _controllerAck = 0;
+  resetStats();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::begin() {
+  _sda.begin();
+  _scl.begin();
+  _sdaLevel = HIGH;
+  _state = IDLE;
+  _lastSda = _sda.read();
+  _lastScl = _scl.read();
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::setRegisters(uint8_t* registers, uint8_t size) {
+  _registers = registers;
+  _size = size;
+  _pointer = 0;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::onPinChange() {
+  uint8_t scl = _scl.read();
+  uint8_t sda = _sda.read();
+
+  _stats.pinChanges++;
+  if (scl == HIGH && _lastScl == HIGH) {
+    if (sda != _lastSda) {
+      if (sda == LOW) start();
+      else stop();
+    }
+  }
+  else if (scl == HIGH) sclRise(sda);
+  else if (_lastScl == HIGH) sclFall();
+  _lastScl = scl;
+  _lastSda = sda;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::start() {
+  // START or repeated START
+  endWrite();
+  releaseSda();
+  _state = ADDRESS;
+  _bit = 0;
+  _shift = 0;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::stop() {
+  endWrite();
+  releaseSda();
+  _state = IDLE;
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::endWrite() {
+  uint8_t count = _writeCount;
+  _writeCount = 0;
+  if (count && _onWrite) _onWrite(_writeStart, count);
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::sclRise(uint8_t sda) {
+  switch (_state) {
+    case ADDRESS:
+    case WRITE:
+      _shift = (_shift << 1) | sda;
+      _bit++;
+      break;
+    case READ_ACK:
+      // The byte just sent is done. Look up the next one now, while SCL is
+      // high, so that the falling edge only has to send its first bit.
+      _controllerAck = (sda == LOW);
+      if (++_pointer >= _size) _pointer = 0;
+      if (_controllerAck) _tx = _size ? _registers[_pointer] : 0xFF;
+      break;
+    default:
+      break;
+  }
+}
+
+// SDA changes only while SCL is low
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::sclFall() {
+  switch (_state) {
+    case ADDRESS:
+      if (_bit < 8) break;
+      if ((_shift >> 1) != _address) {
+        _state = IGNORE;
+        break;
+      }
+      _r_w = _shift & 0x01;
+      if (_r_w) _tx = _size ? _registers[_pointer] : 0xFF;
+      else _pointerSet = false;
+      _stats.addressed++;
+      setSda(LOW);   // ACK
+      _state = ADDRESS_ACK;
+      break;
+    case ADDRESS_ACK:
+    case READ_ACK:
+      if (_state == READ_ACK && !_controllerAck) {  // NACK: controller is done reading
+        _state = IGNORE;
+        break;
+      }
+      if (_r_w) {
+        _mask = 0x80;
+        setSda(_tx & _mask ? HIGH : LOW);
+        _state = READ;
+      }
+      else {
+        setSda(HIGH);
+        _shift = 0;
+        _bit = 0;
+        _state = WRITE;
+      }
+      break;
+    case WRITE:
+      if (_bit < 8) break;
+      if (!_pointerSet) {
+        _pointer = _size ? _shift % _size : 0;
+        _pointerSet = true;
+        _writeStart = _pointer;
+      }
+      else if (_size) {
+        _registers[_pointer] = _shift;
+        if (++_pointer >= _size) _pointer = 0;
+        _writeCount++;
+        _stats.bytesWritten++;
+      }
+      setSda(LOW);   // ACK
+      _state = WRITE_ACK;
+      break;
+    case WRITE_ACK:
+      setSda(HIGH);
+      _shift = 0;
+      _bit = 0;
+      _state = WRITE;
+      break;
+    case READ:
+      _mask >>= 1;
+      if (_mask) setSda(_tx & _mask ? HIGH : LOW);
+      else {
+        setSda(HIGH);   // Release SDA for ACK/NACK from controller
+        _stats.bytesRead++;
+        _state = READ_ACK;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::setSda(uint8_t level) {
+  bool hold = false;
+  if (level == _sdaLevel) return;
+  _sdaLevel = level;
+  if (_stretch) {
+    // If the controller has already raised SCL, holding it now would add a
+    // clock pulse, so the new level is just late
+    hold = (_scl.read() == LOW);
+    if (hold) {
+      _scl.driveLow();
+      _stats.stretches++;
+    }
+    else _stats.late++;
+  }
+  if (level == HIGH) _sda.release();
+  else _sda.driveLow();
+  if (hold) _scl.release();
+}
+
+// At a START or STOP, SCL is high, so it is not held
+template <class SDA_LINE, class SCL_LINE>
+void SWI2CTargetCore<SDA_LINE, SCL_LINE>::releaseSda() {
+  if (_sdaLevel == HIGH) return;
+  _sdaLevel = HIGH;
+  _sda.release();
+}
+
+// Pins are chosen at runtime
+class SWI2CTarget : public SWI2CTargetCore<SWI2C_PinLine, SWI2C_PinLine> {
+public:
+  SWI2CTarget(uint8_t sda_pin, uint8_t scl_pin, uint8_t address);
+};
+
+// Pins are fixed at compile time, e.g. SWI2CTargetT<SDA_PIN, SCL_PIN> target(0x42);
+template <uint8_t SDA_PIN, uint8_t SCL_PIN>
+class SWI2CTargetT : public SWI2CTargetCore<SWI2C_FixedLine<SDA_PIN>, SWI2C_FixedLine<SCL_PIN> > {
+public:
+  SWI2CTargetT(uint8_t address) :
+    SWI2CTargetCore<SWI2C_FixedLine<SDA_PIN>, SWI2C_FixedLine<SCL_PIN> >(SWI2C_FixedLine<SDA_PIN>(), SWI2C_FixedLine<SCL_PIN>(), address) {}
+};
+
+#endif
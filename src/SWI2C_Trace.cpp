@@ -0,0 +1,190 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Waveform trace capture
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+
+#include "SWI2C_Trace.h"
+
+// Levels on the bus as seen by the controller, rebuilt from the events.
+// Devices only change SDA while SCL is low, and the controller does not
+// read SDA then. So after each SCL falling edge, SDA is shown as the
+// controller left it (high if released) until the next read shows otherwise.
+struct SWI2C_TraceLevels {
+  uint8_t sda;
+  uint8_t scl;
+  bool sdaDriven;     // Controller is driving SDA low
+
+  SWI2C_TraceLevels() : sda(HIGH), scl(HIGH), sdaDriven(false) {}
+  void apply(uint8_t event) {
+    uint8_t level;
+    if (event & SWI2C_TRACE_SAMPLE) level = (event & SWI2C_TRACE_LEVEL) ? HIGH : LOW;
+    else level = (event & SWI2C_TRACE_LOW) ? LOW : HIGH;
+    if (event & SWI2C_TRACE_SCL) {
+      scl = level;
+      if (!(event & SWI2C_TRACE_SAMPLE) && level == LOW) sda = sdaDriven ? LOW : HIGH;
+    }
+    else {
+      sda = level;
+      if (!(event & SWI2C_TRACE_SAMPLE)) sdaDriven = (level == LOW);
+    }
+  }
+};
+
+SWI2C_Trace::SWI2C_Trace(SWI2C_TraceEvent* buffer, uint16_t size) {
+  _buffer = buffer;
+  _size = size;
+  _enabled = true;
+  clear();
+}
+
+void SWI2C_Trace::clear() {
+  _count = 0;
+  _overflow = false;
+  _sclLevel = HIGH;
+}
+
+void SWI2C_Trace::printVCD(Print& out) {
+  SWI2C_TraceLevels levels;
+  uint8_t sda = HIGH;
+  uint8_t scl = HIGH;
+  unsigned long t;
+  unsigned long lastTime = 0;
+
+  out.println("$timescale 1us $end");
+  out.println("$scope module swi2c $end");
+  out.println("$var wire 1 d sda $end");
+  out.println("$var wire 1 c scl $end");
+  out.println("$upscope $end");
+  out.println("$enddefinitions $end");
+  out.println("#0");
+  out.println("$dumpvars");
+  out.println("1d");
+  out.println("1c");
+  out.println("$end");
+  for (uint16_t i = 0; i < _count; i++) {
+    levels.apply(_buffer[i].event);
+    if (levels.sda == sda && levels.scl == scl) continue;
+    t = _buffer[i].time - _buffer[0].time;
+    if (t != lastTime) {
+      out.print("#");
+      out.println(t);
+      lastTime = t;
+    }
+    if (levels.sda != sda) out.println(levels.sda ? "1d" : "0d");
+    if (levels.scl != scl) out.println(levels.scl ? "1c" : "0c");
+    sda = levels.sda;
+    scl = levels.scl;
+  }
+}
+
+// Ends a printEvents() line, with the clock stretching since the last line
+static void printStretch(Print& out, unsigned long& stretch) {
+  if (stretch) {
+    out.print(", stretched ");
+    out.print(stretch);
+    out.print(" us");
+    stretch = 0;
+  }
+  out.println("");
+}
+
+void SWI2C_Trace::printEvents(Print& out) {
+  SWI2C_TraceLevels levels;
+  unsigned long t;
+  unsigned long stopTime = 0;
+  unsigned long byteStart = 0;
+  unsigned long stretchStart = 0;
+  unsigned long stretch = 0;    // Clock stretching since the last line printed
+  bool inTransaction = false;
+  bool haveStop = false;
+  bool stretching = false;
+  bool addressByte = false;
+  int8_t bit = 0;       // Bits clocked in the current byte, -1 until the end of the START
+  uint8_t shift = 0;
+  uint8_t event;
+  uint8_t sda;
+
+  for (uint16_t i = 0; i < _count; i++) {
+    event = _buffer[i].event;
+    t = _buffer[i].time - _buffer[0].time;
+    sda = levels.sda;
+    levels.apply(event);
+
+    if (event & SWI2C_TRACE_SCL) {
+      if (event & SWI2C_TRACE_SAMPLE) {
+        if (levels.scl == LOW) {      // Released, but a device is holding it low
+          stretching = true;
+          stretchStart = t;
+        }
+        else if (stretching) {
+          stretching = false;
+          stretch += t - stretchStart;
+        }
+      }
+      else if (event & SWI2C_TRACE_LOW) {   // End of a clock
+        if (!inTransaction) continue;
+        if (bit < 0) {                // End of the START hold time
+          bit = 0;
+          continue;
+        }
+        if (bit < 8) shift = (shift << 1) | sda;
+        if (++bit == 9) {
+          out.print(byteStart);
+          if (addressByte) {
+            out.print(" ADDRESS 0x");
+            out.print(shift >> 1, HEX);
+            out.print((shift & 1) ? " R" : " W");
+          }
+          else {
+            out.print(" DATA 0x");
+            out.print(shift, HEX);
+          }
+          out.print((sda == LOW) ? " ACK " : " NACK ");
+          out.print(t - byteStart);
+          out.print(" us");
+          printStretch(out, stretch);
+          addressByte = false;
+          bit = 0;
+        }
+      }
+      else if (inTransaction && bit == 0) byteStart = t;   // First clock of a byte
+    }
+    else if (!(event & SWI2C_TRACE_SAMPLE) && levels.scl == HIGH && levels.sda != sda) {
+      // Controller changed SDA while SCL is high
+      out.print(t);
+      if (levels.sda == LOW) {
+        if (inTransaction) out.print(" RESTART");
+        else {
+          out.print(" START");
+          if (haveStop) {
+            out.print(" idle ");
+            out.print(t - stopTime);
+            out.print(" us");
+          }
+        }
+        printStretch(out, stretch);
+        inTransaction = true;
+        addressByte = true;
+        bit = -1;
+        shift = 0;
+      }
+      else {
+        out.print(" STOP");
+        printStretch(out, stretch);
+        inTransaction = false;
+        haveStop = true;
+        stopTime = t;
+      }
+    }
+  }
+  if (_overflow) out.println("Trace buffer full: later events were not recorded.");
+}
+
+SWI2CBusTrace::SWI2CBusTrace(uint8_t sda_pin, uint8_t scl_pin, SWI2C_Trace& trace) :
+  SWI2CBusCore<SWI2C_TraceLine<SWI2C_PinLine>, SWI2C_TraceLine<SWI2C_PinLine> >(
+    SWI2C_TraceLine<SWI2C_PinLine>(SWI2C_PinLine(sda_pin), trace, SWI2C_TRACE_SDA),
+    SWI2C_TraceLine<SWI2C_PinLine>(SWI2C_PinLine(scl_pin), trace, SWI2C_TRACE_SCL), true) {
+}
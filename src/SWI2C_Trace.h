@@ -0,0 +1,141 @@
+/* -----------------------------------------------------------------
+   SWI2C Library - Waveform trace capture
+   https://github.com/Andy4495/SWI2C
+   MIT License
+
+   10/16/2026 - Andy4495 - Original
+*/
+/* -----------------------------------------------------------------
+   SWI2C_TraceLine wraps a pin line class (SWI2C_PinLine, SWI2C_FixedLine,
+   SWI2C_SimLine, ...) and records each pin write, each SDA read, and
+   each change seen by an SCL read, with a micros() timestamp, in an
+   SWI2C_Trace buffer.
+   Only buses built from traced lines are affected, so there is no cost
+   when tracing is not used:
+
+     SWI2C_TraceEvent events[256];
+     SWI2C_Trace trace(events, 256);
+     SWI2CBusTrace bus(SDA_PIN, SCL_PIN, trace);
+     SWI2CDeviceTrace myDevice(bus, 0x68);
+     ...
+     trace.printEvents(Serial);   // START, address, data, ACK, STOP, stretches
+     trace.printVCD(Serial);      // Save the output as a .vcd file for GTKWave
+
+   The buffer is filled from the start and recording stops when it is
+   full (see overflowed()). Reading micros() at every edge slows the bus
+   down, so bit periods measured on a board are longer than without the
+   trace. On the simulated bus, timestamps are simulated time and are
+   not affected.
+   -----------------------------------------------------------------
+*/
+
+#ifndef SWI2C_TRACE_H
+#define SWI2C_TRACE_H
+
+#include "Arduino.h"
+#include "SWI2C_PinDriver.h"
+#include "SWI2C_Core.h"
+
+// Event codes: line, then what the controller did
+#define SWI2C_TRACE_SDA       0x00
+#define SWI2C_TRACE_SCL       0x01
+#define SWI2C_TRACE_RELEASE   0x00   // Line released (pulled high unless a device holds it low)
+#define SWI2C_TRACE_LOW       0x02   // Line driven low
+#define SWI2C_TRACE_SAMPLE    0x04   // Line read (SCL: only when the level changed)
+#define SWI2C_TRACE_LEVEL     0x08   // Level read, for SWI2C_TRACE_SAMPLE
+
+struct SWI2C_TraceEvent {
+  unsigned long time;   // micros()
+  uint8_t event;        // SWI2C_TRACE_* bits
+};
+
+class SWI2C_Trace {
+public:
+  SWI2C_Trace(SWI2C_TraceEvent* buffer, uint16_t size);
+
+  void record(unsigned long time, uint8_t event) {
+    if (!_enabled) return;
+    if (event & SWI2C_TRACE_SCL) {
+      // Only SCL changes are recorded, so each clock stretch uses 2 events
+      uint8_t level;
+      if (event & SWI2C_TRACE_SAMPLE) {
+        level = (event & SWI2C_TRACE_LEVEL) ? HIGH : LOW;
+        if (level == _sclLevel) return;
+      }
+      else level = (event & SWI2C_TRACE_LOW) ? LOW : HIGH;
+      _sclLevel = level;
+    }
+    if (_count == _size) {
+      _overflow = true;
+      return;
+    }
+    _buffer[_count].time = time;
+    _buffer[_count].event = event;
+    _count++;
+  }
+
+  void clear();
+  void setEnabled(bool enabled) {_enabled = enabled;}
+  uint16_t getCount() {return _count;}
+  const SWI2C_TraceEvent& getEvent(uint16_t i) {return _buffer[i];}
+  // True if events were lost because the buffer was full
+  bool overflowed() {return _overflow;}
+
+  // Value Change Dump of the SDA and SCL levels, with a 1 us timescale
+  // starting at the first event
+  void printVCD(Print& out);
+  // One line per protocol event, with the time in us from the first event:
+  // START (with the idle time since the last STOP), RESTART, address and
+  // data bytes with ACK/NACK and the time taken by their 9 clocks,
+  // clock stretches, and STOP
+  void printEvents(Print& out);
+
+private:
+  SWI2C_TraceEvent* _buffer;
+  uint16_t _size;
+  uint16_t _count;
+  bool _overflow;
+  bool _enabled;
+  uint8_t _sclLevel;    // Last SCL level recorded
+};
+
+// LINE is any pin line class with begin(), release(), driveLow(), read(),
+// isReleased(), getMillis(), and getMicros().
+template <class LINE>
+class SWI2C_TraceLine {
+public:
+  // <id> is SWI2C_TRACE_SDA or SWI2C_TRACE_SCL
+  SWI2C_TraceLine(const LINE& line, SWI2C_Trace& trace, uint8_t id) : _line(line), _trace(&trace), _id(id) {}
+  void begin() {_line.begin();}
+  void release() {
+    _line.release();
+    _trace->record(_line.getMicros(), _id | SWI2C_TRACE_RELEASE);
+  }
+  void driveLow() {
+    _line.driveLow();
+    _trace->record(_line.getMicros(), _id | SWI2C_TRACE_LOW);
+  }
+  uint8_t read() {
+    uint8_t level = _line.read();
+    _trace->record(_line.getMicros(), _id | SWI2C_TRACE_SAMPLE | (level ? SWI2C_TRACE_LEVEL : 0));
+    return level;
+  }
+  bool isReleased() {return _line.isReleased();}
+  unsigned long getMillis() {return _line.getMillis();}
+  unsigned long getMicros() {return _line.getMicros();}
+
+private:
+  LINE _line;
+  SWI2C_Trace* _trace;
+  uint8_t _id;
+};
+
+// Shared bus (like SWI2CBus) with both lines traced
+class SWI2CBusTrace : public SWI2CBusCore<SWI2C_TraceLine<SWI2C_PinLine>, SWI2C_TraceLine<SWI2C_PinLine> > {
+public:
+  SWI2CBusTrace(uint8_t sda_pin, uint8_t scl_pin, SWI2C_Trace& trace);
+};
+
+typedef SWI2CDeviceT<SWI2CBusTrace> SWI2CDeviceTrace;
+
+#endif